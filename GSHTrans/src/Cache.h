@@ -0,0 +1,404 @@
+#ifndef GSH_TRANS_CACHE_GUARD_H
+#define GSH_TRANS_CACHE_GUARD_H
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cerrno>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Concepts.h"
+
+namespace GSHTrans {
+
+// Memory mapping of a file opened for reading. Pages are mapped privately
+// so that values can be accessed through mutable views without the file
+// itself being changed.
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  explicit MappedFile(const std::filesystem::path& path) {
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      auto size = static_cast<std::size_t>(info.st_size);
+      auto address =
+          ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED) {
+        _data = static_cast<std::byte*>(address);
+        _size = size;
+      }
+    }
+    ::close(fd);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (_data) ::munmap(_data, _size);
+  }
+
+  explicit operator bool() const { return _data != nullptr; }
+
+  auto data() const { return _data; }
+  auto size() const { return _size; }
+
+ private:
+  std::byte* _data = nullptr;
+  std::size_t _size = 0;
+};
+
+// Memory mapping of a named POSIX shared memory segment opened for
+// reading. The pages are shared with all other processes mapping the
+// segment, so that a node holds a single copy of the values. They are
+// mapped read only and so must not be written to through any view. The
+// segment starts with a block holding the process id of its creator,
+// which is followed by the values viewed through data() and size().
+class SharedSegment {
+ public:
+  SharedSegment() = default;
+
+  // Maps an existing segment. The object is empty if the segment does
+  // not exist or has not yet been given a size by its creator.
+  explicit SharedSegment(const std::string& name) {
+    auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 &&
+        static_cast<std::size_t>(info.st_size) >= OwnerBytes) {
+      auto size = static_cast<std::size_t>(info.st_size);
+      auto address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (address != MAP_FAILED) {
+        _data = static_cast<std::byte*>(address);
+        _size = size;
+      }
+    }
+    ::close(fd);
+  }
+
+  SharedSegment(const SharedSegment&) = delete;
+  SharedSegment& operator=(const SharedSegment&) = delete;
+
+  ~SharedSegment() {
+    if (_data) ::munmap(_data, _size);
+  }
+
+  explicit operator bool() const { return _data != nullptr; }
+
+  auto data() const { return _data + OwnerBytes; }
+  auto size() const { return _size - OwnerBytes; }
+
+  // Returns the process id of the creator of the segment.
+  ::pid_t Owner() const {
+    return std::atomic_ref(*reinterpret_cast<::pid_t*>(_data))
+        .load(std::memory_order_acquire);
+  }
+
+  // Returns true if the creator of the segment is no longer running.
+  bool Orphaned() const {
+    return ::kill(Owner(), 0) != 0 && errno == ESRCH;
+  }
+
+  // Creates a segment holding only the process id of the caller,
+  // returning false if it already exists. The process that creates a
+  // segment is the one expected to write it.
+  static bool Create(const std::string& name) {
+    auto fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) return false;
+    auto address = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(OwnerBytes)) == 0) {
+      address = ::mmap(nullptr, OwnerBytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      Remove(name);
+      return false;
+    }
+    std::atomic_ref(*static_cast<::pid_t*>(address))
+        .store(::getpid(), std::memory_order_release);
+    ::munmap(address, OwnerBytes);
+    return true;
+  }
+
+  static bool Exists(const std::string& name) {
+    auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    ::close(fd);
+    return true;
+  }
+
+  // Removes the name of a segment. Existing mappings remain valid.
+  static void Remove(const std::string& name) { ::shm_unlink(name.c_str()); }
+
+  // Size in bytes of the block holding the creator's process id, which
+  // keeps the values that follow aligned.
+  static constexpr std::size_t OwnerBytes = 64;
+
+ private:
+  std::byte* _data = nullptr;
+  std::size_t _size = 0;
+};
+
+// Options for grids whose values are held in shared memory. The prefix
+// distinguishes the segments of unrelated jobs on a node, and processes
+// that find a segment still being written wait up to the timeout for it
+// before computing the values themselves. They stop waiting as soon as
+// the creator of the segment is found to have died.
+struct SharedMemory {
+  std::string prefix = "GSHTrans";
+  std::chrono::seconds timeout{600};
+};
+
+// Binary cache of arrays of values. A file consists of a header followed
+// by the arrays, each starting on a 64 byte boundary. The header records a
+// format version, the sizes of the arrays in bytes, and a key listing the
+// types and parameters used to compute the values. A file is only used if
+// the version and key match.
+class Cache {
+  using Int = std::int64_t;
+
+ public:
+  using Key = std::vector<Int>;
+
+  // A mapping of a cache along with views to the arrays within it.
+  template <typename Mapping>
+  using Contents =
+      std::pair<std::shared_ptr<Mapping>, std::vector<std::span<std::byte>>>;
+
+  // Reads the arrays from a file, returning a pointer to its mapping along
+  // with views to each array. The pointer is null if the file does not
+  // exist or does not match the key.
+  static auto Read(const std::filesystem::path& path, const Key& key) {
+    return Parse(std::make_shared<MappedFile>(path), key);
+  }
+
+  // As above, but reading the arrays from a shared memory segment. If the
+  // segment exists but is still being written, this waits up to the
+  // given time for it to be completed. A segment whose creator has died
+  // before completing it, or which has been left without a size for a
+  // second, is removed so that the caller can create it again.
+  static auto ReadShared(const std::string& name, const Key& key,
+                         std::chrono::duration<double> timeout) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto finish = start + timeout;
+    while (true) {
+      auto segment = std::make_shared<SharedSegment>(name);
+      if (*segment && segment->size() >= sizeof(Int) &&
+          Ready(segment->data())) {
+        return Parse(std::move(segment), key);
+      }
+      auto orphaned = *segment ? segment->Orphaned()
+                               : Clock::now() > start + std::chrono::seconds(1);
+      if (orphaned) RemoveOrphaned(name);
+      if (orphaned || !SharedSegment::Exists(name) ||
+          Clock::now() > finish) {
+        return Parse(std::shared_ptr<SharedSegment>{}, key);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  // Writes the arrays to a file. The data is first written to a temporary
+  // file within the same directory which is then renamed, so that other
+  // processes never see a partially written cache. Returns false if the
+  // file could not be written.
+  static bool Write(const std::filesystem::path& path, const Key& key,
+                    std::initializer_list<std::span<const std::byte>> arrays) {
+    auto sizes = std::vector<std::size_t>{};
+    for (auto array : arrays) sizes.push_back(array.size());
+    auto header = Header(key, sizes);
+
+    auto temporary = path;
+    temporary += ".tmp" + std::to_string(::getpid());
+    {
+      auto file = std::ofstream(temporary, std::ios::binary);
+      if (!file) return false;
+      auto pad = [&file](std::size_t size) {
+        auto zeros = std::vector<char>(Aligned(size) - size);
+        file.write(zeros.data(), zeros.size());
+      };
+      file.write(reinterpret_cast<const char*>(header.data()),
+                 header.size() * sizeof(Int));
+      pad(header.size() * sizeof(Int));
+      for (auto array : arrays) {
+        file.write(reinterpret_cast<const char*>(array.data()), array.size());
+        pad(array.size());
+      }
+      if (!file) {
+        file.close();
+        auto error = std::error_code{};
+        std::filesystem::remove(temporary, error);
+        return false;
+      }
+    }
+
+    auto error = std::error_code{};
+    std::filesystem::rename(temporary, path, error);
+    if (error) std::filesystem::remove(temporary, error);
+    return !error;
+  }
+
+  // Writes the arrays to a shared memory segment already created by this
+  // process. The first word of the header is written last, so that other
+  // processes only read the segment once it is complete. Returns false if
+  // the segment could not be written.
+  static bool WriteShared(
+      const std::string& name, const Key& key,
+      std::initializer_list<std::span<const std::byte>> arrays) {
+    auto sizes = std::vector<std::size_t>{};
+    for (auto array : arrays) sizes.push_back(array.size());
+    auto header = Header(key, sizes);
+    auto size = Aligned(header.size() * sizeof(Int));
+    for (auto array : arrays) size += Aligned(array.size());
+
+    // The values follow the block holding the creator's process id.
+    size += SharedSegment::OwnerBytes;
+    auto fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) return false;
+    auto address = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+      address =
+          ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (address == MAP_FAILED) return false;
+
+    auto data = static_cast<std::byte*>(address) + SharedSegment::OwnerBytes;
+    std::memcpy(data + sizeof(Int), header.data() + 1,
+                (header.size() - 1) * sizeof(Int));
+    auto offset = Aligned(header.size() * sizeof(Int));
+    for (auto array : arrays) {
+      std::memcpy(data + offset, array.data(), array.size());
+      offset += Aligned(array.size());
+    }
+    std::atomic_ref(*reinterpret_cast<Int*>(data))
+        .store(header.front(), std::memory_order_release);
+    ::munmap(address, size);
+    return true;
+  }
+
+  // Returns a key entry identifying a floating point type.
+  template <RealFloatingPoint Real>
+  static Int Type() {
+    return static_cast<Int>(sizeof(Real)) * 1024 +
+           std::numeric_limits<Real>::digits;
+  }
+
+  // Returns a view to an array read from a file as values of type T.
+  template <typename T>
+  static std::span<T> As(std::span<std::byte> bytes) {
+    return std::span(reinterpret_cast<T*>(bytes.data()),
+                     bytes.size() / sizeof(T));
+  }
+
+ private:
+  // Change whenever the layout of the cached values changes.
+  static constexpr Int Version = 3;
+
+  // "GSHTrans" as an integer, which also detects a change of byte order.
+  static constexpr Int Magic = 0x736e617254485347;
+
+  static constexpr std::size_t Alignment = 64;
+
+  static constexpr std::size_t Aligned(std::size_t size) {
+    return (size + Alignment - 1) / Alignment * Alignment;
+  }
+
+  // Removes a segment left incomplete by a creator that has died. The
+  // segment is first mapped again, so that one completed or made since by
+  // a running process is left in place.
+  static void RemoveOrphaned(const std::string& name) {
+    auto segment = SharedSegment(name);
+    if (segment) {
+      if (segment.size() >= sizeof(Int) && Ready(segment.data())) return;
+      if (!segment.Orphaned()) return;
+    }
+    SharedSegment::Remove(name);
+  }
+
+  // Returns true once the writer of a shared segment has completed it.
+  static bool Ready(std::byte* data) {
+    return std::atomic_ref(*reinterpret_cast<Int*>(data))
+               .load(std::memory_order_acquire) == Magic;
+  }
+
+  // Returns views to the arrays held within a mapping along with the
+  // mapping itself. The pointer is null if the mapping is empty or its
+  // header does not match the key.
+  template <typename Mapping>
+  static Contents<Mapping> Parse(std::shared_ptr<Mapping> file,
+                                 const Key& key) {
+    auto arrays = std::vector<std::span<std::byte>>{};
+    auto none = Contents<Mapping>{nullptr, arrays};
+
+    if (!file || !*file) return none;
+    auto words = std::span(reinterpret_cast<const Int*>(file->data()),
+                           file->size() / sizeof(Int));
+
+    auto prefix = Prefix(key);
+    if (words.size() <= prefix.size() ||
+        !std::ranges::equal(prefix, words.first(prefix.size()))) {
+      return none;
+    }
+    auto nArrays = words[prefix.size()];
+    if (nArrays < 0 ||
+        words.size() < prefix.size() + 1 + static_cast<std::size_t>(nArrays)) {
+      return none;
+    }
+
+    auto sizes = words.subspan(prefix.size() + 1, nArrays);
+    auto offset = Aligned((prefix.size() + 1 + nArrays) * sizeof(Int));
+    for (auto size : sizes) {
+      auto bytes = static_cast<std::size_t>(size);
+      if (size < 0 || offset + bytes > file->size()) return none;
+      arrays.push_back(std::span(file->data() + offset, bytes));
+      offset += Aligned(bytes);
+    }
+    return {file, arrays};
+  }
+
+  // Values identifying the format and parameters of a cache.
+  static std::vector<Int> Prefix(const Key& key) {
+    auto prefix =
+        std::vector<Int>{Magic, Version, static_cast<Int>(key.size())};
+    prefix.insert(prefix.end(), key.begin(), key.end());
+    return prefix;
+  }
+
+  static std::vector<Int> Header(const Key& key,
+                                 const std::vector<std::size_t>& sizes) {
+    auto header = Prefix(key);
+    header.push_back(static_cast<Int>(sizes.size()));
+    header.insert(header.end(), sizes.begin(), sizes.end());
+    return header;
+  }
+};
+
+}  // namespace GSHTrans
+
+#endif  // GSH_TRANS_CACHE_GUARD_H
@@ -304,11 +304,12 @@ class FormConstantCanonicalComponentView
 //--------------------------------------------------------//
 
 namespace CanonicalComponentDetails {
+// The component's precision is kept so that, e.g., a float component can
+// be scaled by a std::complex<double>.
 template <Field S, Field T>
 struct ReturnValueHelper {
-  using type =
-      std::conditional_t<ComplexFloatingPoint<T>, T,
-                         std::conditional_t<ComplexFloatingPoint<S>, S, T>>;
+  using type = std::conditional_t<ComplexFloatingPoint<S>,
+                                  std::complex<RemoveComplex<T>>, T>;
 };
 
 template <Field S, Field T>
@@ -26,13 +26,16 @@ struct NonNegative {};
 struct Single {};
 struct Multiple {};
 
+// A set of upper indices given at run time, such as {-2, 0, 2}.
+struct Sparse {};
+
 struct UpperIndexFirst {};
 struct AngleFirst {};
 
 template <typename Indices>
 concept IndexRange =
     std::same_as<Indices, All> or std::same_as<Indices, NonNegative> or
-    std::same_as<Indices, Single>;
+    std::same_as<Indices, Single> or std::same_as<Indices, Sparse>;
 
 template <typename Indices>
 concept OrderIndexRange =
@@ -49,6 +52,40 @@ struct FourPi {};
 template <typename Norm>
 concept Normalisation = std::same_as<Norm, Ortho> or std::same_as<Norm, FourPi>;
 
+// Wigner evaluation options. Lazy evaluation stores the values for each
+// upper index once they are first needed.
+struct Precomputed {};
+struct OnTheFly {};
+struct Lazy {};
+
+template <typename T>
+concept WignerEvaluation = std::same_as<T, Precomputed> or
+                           std::same_as<T, OnTheFly> or std::same_as<T, Lazy>;
+
+// Grid symmetry options.
+struct NoSymmetry {};
+struct Equatorial {};
+
+template <typename T>
+concept GridSymmetry =
+    std::same_as<T, NoSymmetry> or std::same_as<T, Equatorial>;
+
+// Wigner storage precision options.
+struct FullPrecision {};
+struct SinglePrecision {};
+
+template <typename T>
+concept WignerPrecision =
+    std::same_as<T, FullPrecision> or std::same_as<T, SinglePrecision>;
+
+// Wigner derivative options.
+struct ValuesOnly {};
+struct WithDerivatives {};
+
+template <typename T>
+concept WignerDerivatives =
+    std::same_as<T, ValuesOnly> or std::same_as<T, WithDerivatives>;
+
 // Value type options.
 struct RealValued {};
 struct ComplexValued {};
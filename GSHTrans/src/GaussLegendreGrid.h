@@ -1,78 +1,292 @@
 #ifndef GSH_TRANS_GAUSS_LEGENDRE_GRID_GUARD_H
 #define GSH_TRANS_GAUSS_LEGENDRE_GRID_GUARD_H
 
+#include <fftw3.h>
+#include <unistd.h>
+
 #include <FFTWpp/Core>
 #include <FFTWpp/Ranges>
 #include <GaussQuad/All>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <numbers>
 #include <numeric>
 #include <ranges>
+#include <span>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Cache.h"
 #include "Concepts.h"
 #include "GridBase.h"
+#include "Registry.h"
 #include "Indexing.h"
+#include "LegendreKernels.h"
+#include "Tuning.h"
 #include "Wigner.h"
 
 namespace GSHTrans {
 
-template <RealFloatingPoint Real, OrderIndexRange MRange, IndexRange NRange>
+template <RealFloatingPoint Real, OrderIndexRange MRange, IndexRange NRange,
+          WignerEvaluation Evaluation = Precomputed,
+          GridSymmetry Symmetry = NoSymmetry, IndexRange NStorage = NRange,
+          WignerPrecision Precision = FullPrecision>
+requires(std::same_as<Symmetry, NoSymmetry> or std::same_as<MRange, All>) and
+        (std::same_as<NStorage, NRange> or
+         (std::same_as<NRange, All> and std::same_as<NStorage, NonNegative> and
+          std::same_as<MRange, All>))
 class GaussLegendreGrid
-    : public GridBase<GaussLegendreGrid<Real, MRange, NRange>> {
+    : public GridBase<GaussLegendreGrid<Real, MRange, NRange, Evaluation,
+                                        Symmetry, NStorage, Precision>> {
  private:
   using Int = std::ptrdiff_t;
   using Complex = std::complex<Real>;
 
-  using WignerType = Wigner<Real, Ortho, MRange, NRange, Multiple, ColumnMajor>;
+  // Stored Wigner values can be held in single precision to halve the
+  // memory used and the bandwidth needed within the transforms. Sums are
+  // still accumulated in the precision of the grid. Each value is then
+  // correct to a relative error of 2^-24, and so the error in a transformed
+  // value is bounded by 2^-24 times the sum of the magnitudes of the terms
+  // contributing to it. For random coefficients, this gives relative errors
+  // of about 1e-7 up to high degree.
+  using WignerReal = std::conditional_t<
+      std::same_as<Precision, SinglePrecision>, float, Real>;
+  using WignerType = Wigner<WignerReal, Ortho, MRange, NRange, Multiple,
+                            ColumnMajor, NStorage>;
+  using RowWignerType =
+      Wigner<Real, Ortho, MRange, Single, Single, ColumnMajor>;
+  using LazyWignerType =
+      Wigner<WignerReal, Ortho, MRange, Single, Multiple, ColumnMajor>;
+
+  // Tables for each upper index built on first use. Copies of the grid
+  // share the tables.
+  struct LazyWigner {
+    LazyWigner(std::size_t size) : flags(size), tables(size) {}
+    std::vector<std::once_flag> flags;
+    std::vector<std::unique_ptr<LazyWignerType>> tables;
+  };
   using QuadType = GaussQuad::Quadrature1D<Real>;
 
+  // FFT plans and work arrays used by a thread within a transform. The
+  // block plan transforms a block of consecutive rows at once, and the
+  // row plan any rows left over. The plans refer to the work arrays, and
+  // so a workspace is not moved. They are executed on rows starting at
+  // any offset within fields and buffers, and so are made for unaligned
+  // data.
+  template <RealOrComplexFloatingPoint In, RealOrComplexFloatingPoint Out,
+            bool Forward>
+  struct Workspace {
+    Workspace(Int nPhi, Int blockSize)
+        : inWork(blockSize * FFTWpp::DataSize<In, Out>(nPhi).first),
+          outWork(blockSize * FFTWpp::DataSize<In, Out>(nPhi).second),
+          rowIn(FFTWpp::DataSize<In, Out>(nPhi).first),
+          rowOut(FFTWpp::DataSize<In, Out>(nPhi).second),
+          blockPlan(MakePlan(
+              FFTWpp::Ranges::View(inWork, BlockLayout(rowIn, blockSize)),
+              FFTWpp::Ranges::View(outWork, BlockLayout(rowOut, blockSize)))),
+          rowPlan(MakePlan(FFTWpp::Ranges::View(rowIn),
+                           FFTWpp::Ranges::View(rowOut))) {}
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    static auto MakePlan(auto in, auto out) {
+      if constexpr (ComplexFloatingPoint<In> and ComplexFloatingPoint<Out>) {
+        return FFTWpp::Ranges::Plan(
+            in, out, FFTWpp::WisdomOnly | FFTWpp::Unaligned,
+            Forward ? FFTWpp::Forward : FFTWpp::Backward);
+      } else {
+        return FFTWpp::Ranges::Plan(in, out,
+                                    FFTWpp::WisdomOnly | FFTWpp::Unaligned);
+      }
+    }
+
+    // Layout of a block of contiguous rows, each the size of row.
+    static auto BlockLayout(const auto& row, Int blockSize) {
+      auto size = static_cast<int>(row.size());
+      return FFTWpp::Ranges::Layout(1, std::vector{size},
+                                    static_cast<int>(blockSize),
+                                    std::vector{size}, 1, size);
+    }
+
+    FFTWpp::vector<In> inWork;
+    FFTWpp::vector<Out> outWork;
+    FFTWpp::vector<In> rowIn;
+    FFTWpp::vector<Out> rowOut;
+    decltype(MakePlan(
+        FFTWpp::Ranges::View(inWork, BlockLayout(rowIn, 1)),
+        FFTWpp::Ranges::View(outWork, BlockLayout(rowOut, 1)))) blockPlan;
+    decltype(MakePlan(FFTWpp::Ranges::View(rowIn),
+                      FFTWpp::Ranges::View(rowOut))) rowPlan;
+
+    // Buffer for the FFT'd rows of a field, held in (theta, m) order, and
+    // for partial sums of the coefficients within forward transforms.
+    FFTWpp::vector<Complex> rows;
+    FFTWpp::vector<Complex> partials;
+
+    // Coefficients of a batch of fields, FFT'd rows of a block for each
+    // member of a batch, and the scaled Wigner values and row or
+    // coefficient offsets for each term of the batched sums.
+    FFTWpp::vector<Complex> coefficients;
+    FFTWpp::vector<Complex> blockRows;
+    std::vector<Real> values;
+    std::vector<Int> offsets;
+  };
+
+  // Wigner values at a single colatitude for transforms computing them
+  // on the fly, held for each upper index. These are computed again in
+  // place at each colatitude, so that only the first use allocates.
+  struct RowWigners {
+    std::vector<std::vector<RowWignerType>> wigners;
+  };
+
+  // Workspaces not in use, shared between copies of the grid. Storage for
+  // as many as have been made is reserved, so that returning one never
+  // allocates.
+  template <typename W>
+  struct Pool {
+    std::vector<std::unique_ptr<W>> free;
+    std::size_t made = 0;
+  };
+
+  struct Workspaces {
+    std::mutex mutex;
+    std::tuple<Pool<Workspace<Real, Complex, true>>,
+               Pool<Workspace<Complex, Complex, true>>,
+               Pool<Workspace<Complex, Real, false>>,
+               Pool<Workspace<Complex, Complex, false>>, Pool<RowWigners>>
+        pools;
+    std::atomic<std::size_t> built = 0;
+  };
+
+  // A workspace taken from the pool, which is returned to it when the
+  // lease ends.
+  template <typename W>
+  class Lease {
+   public:
+    Lease(std::shared_ptr<Workspaces> workspaces, std::unique_ptr<W> workspace)
+        : _workspaces{std::move(workspaces)},
+          _workspace{std::move(workspace)} {}
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    ~Lease() {
+      auto lock = std::lock_guard(_workspaces->mutex);
+      std::get<Pool<W>>(_workspaces->pools)
+          .free.push_back(std::move(_workspace));
+    }
+
+    W& operator*() const { return *_workspace; }
+    W* operator->() const { return _workspace.get(); }
+
+   private:
+    std::shared_ptr<Workspaces> _workspaces;
+    std::unique_ptr<W> _workspace;
+  };
+
  public:
   using real_type = Real;
   using complex_type = Complex;
   using MRange_type = MRange;
   using NRange_type = NRange;
+  using evaluation_type = Evaluation;
+  using symmetry_type = Symmetry;
+  using precision_type = Precision;
 
   // Constructors.
   GaussLegendreGrid() = default;
 
   GaussLegendreGrid(int lMax, int nMax, FFTWpp::Flag flag = FFTWpp::Measure)
+  requires(!std::same_as<NRange, Sparse>)
       : _lMax{lMax}, _nMax{nMax} {
-    // Check the inputs.
-    assert(MaxDegree() >= 0);
-    assert(MaxUpperIndex() <= MaxDegree());
-    assert(std::abs(this->MinUpperIndex()) <= MaxDegree());
+    CheckInputs();
+    ComputeQuadrature();
+    ComputeWigner();
+    GenerateWisdom(flag);
+  }
 
-    // Get the quadrature points.
-    _quadPointer = std::make_shared<QuadType>(
-        GaussQuad::LegendrePolynomial<Real>{}.GaussQuadrature(_lMax + 1));
+  // Construct the grid using a cache file within the given directory. If
+  // a matching file exists, the quadrature and Wigner values are mapped
+  // from it into memory. Otherwise they are computed and then written to
+  // the file for later use.
+  GaussLegendreGrid(int lMax, int nMax,
+                    const std::filesystem::path& cacheDirectory,
+                    FFTWpp::Flag flag = FFTWpp::Measure)
+  requires(!std::same_as<NRange, Sparse>)
+      : _lMax{lMax}, _nMax{nMax} {
+    CheckInputs();
+    UseCache(cacheDirectory / CacheFileName());
+    GenerateWisdom(flag);
+  }
 
-    _quadPointer->Transform([](auto x) { return std::acos(-x); },
-                            [](auto x) -> Real { return 1; });
+  // Construct the grid for a given set of upper indices, such as {-2, 0,
+  // 2} for a symmetric tensor, so that Wigner values are only computed
+  // and stored for those indices.
+  GaussLegendreGrid(int lMax, std::vector<Int> upperIndices,
+                    FFTWpp::Flag flag = FFTWpp::Measure)
+  requires std::same_as<NRange, Sparse>
+      : _lMax{lMax},
+        _upperIndices{SortedUpperIndices(std::move(upperIndices))},
+        _nMax{_upperIndices.back()} {
+    CheckInputs();
+    ComputeQuadrature();
+    ComputeWigner();
+    GenerateWisdom(flag);
+  }
 
-    //  Get the Winger values.
-    _wignerPointer = std::make_shared<WignerType>(_lMax, _lMax, _nMax,
-                                                  _quadPointer->Points());
+  GaussLegendreGrid(int lMax, std::vector<Int> upperIndices,
+                    const std::filesystem::path& cacheDirectory,
+                    FFTWpp::Flag flag = FFTWpp::Measure)
+  requires std::same_as<NRange, Sparse>
+      : _lMax{lMax},
+        _upperIndices{SortedUpperIndices(std::move(upperIndices))},
+        _nMax{_upperIndices.back()} {
+    CheckInputs();
+    UseCache(cacheDirectory / CacheFileName());
+    GenerateWisdom(flag);
+  }
 
-    if (_lMax > 0) {
-      // Generate wisdom for FFTs.
-      auto nPhi = this->NumberOfLongitudes();
-      auto in = FFTWpp::Ranges::Layout(nPhi);
-      {
-        // Real to complex case.
-        auto out = FFTWpp::Ranges::Layout(nPhi / 2 + 1);
-        FFTWpp::GenerateWisdom<Real, Complex>(in, out, flag);
-      }
-      {
-        // Complex to complex case.
-        auto out = FFTWpp::Ranges::Layout(nPhi);
-        FFTWpp::GenerateWisdom<Complex, Complex>(in, out, flag);
-      }
-    }
+  // Construct the grid using values held in a POSIX shared memory
+  // segment, so that processes on a node share a single copy. The first
+  // process to ask for the segment computes and writes the values, while
+  // the others wait for it and then map them read only. Segments persist
+  // until removed using SharedSegment::Remove(SharedMemoryName(shared)).
+  GaussLegendreGrid(int lMax, int nMax, const SharedMemory& shared,
+                    FFTWpp::Flag flag = FFTWpp::Measure)
+  requires(!std::same_as<NRange, Sparse>)
+      : _lMax{lMax}, _nMax{nMax} {
+    CheckInputs();
+    UseSharedMemory(shared);
+    GenerateWisdom(flag);
+  }
+
+  GaussLegendreGrid(int lMax, std::vector<Int> upperIndices,
+                    const SharedMemory& shared,
+                    FFTWpp::Flag flag = FFTWpp::Measure)
+  requires std::same_as<NRange, Sparse>
+      : _lMax{lMax},
+        _upperIndices{SortedUpperIndices(std::move(upperIndices))},
+        _nMax{_upperIndices.back()} {
+    CheckInputs();
+    UseSharedMemory(shared);
+    GenerateWisdom(flag);
   }
 
   GaussLegendreGrid(const GaussLegendreGrid&) = default;
@@ -83,12 +297,203 @@ class GaussLegendreGrid
 
   GaussLegendreGrid& operator=(GaussLegendreGrid&&) = default;
 
+  // Returns the name of the cache file for the grid's parameters.
+  std::string CacheFileName() const {
+    auto name = [](auto range) -> std::string {
+      using Range = decltype(range);
+      if constexpr (std::same_as<Range, All>) {
+        return "All";
+      } else if constexpr (std::same_as<Range, NonNegative>) {
+        return "NonNegative";
+      } else if constexpr (std::same_as<Range, Sparse>) {
+        return "Sparse";
+      } else {
+        return "Single";
+      }
+    };
+    auto upperIndices = std::string{};
+    for (auto n : _upperIndices) upperIndices += "_" + std::to_string(n);
+    auto evaluation = []() -> std::string {
+      if constexpr (std::same_as<Evaluation, Precomputed>) {
+        return "Precomputed";
+      } else if constexpr (std::same_as<Evaluation, OnTheFly>) {
+        return "OnTheFly";
+      } else {
+        return "Lazy";
+      }
+    }();
+    return "GaussLegendreGrid_" + std::to_string(sizeof(Real)) + "_" +
+           std::to_string(sizeof(WignerReal)) + "_" + name(MRange{}) + "_" +
+           name(NRange{}) + "_" + name(NStorage{}) + "_" +
+           std::to_string(_lMax) + "_" + std::to_string(_nMax) +
+           upperIndices + "_" +
+           std::to_string(NumberOfStoredCoLatitudes(_lMax + 1)) + "_" +
+           evaluation + ".bin";
+  }
+
+  // Builds the Wigner values for upper index n ahead of the first
+  // transform that needs them. This does nothing unless evaluation is lazy.
+  void Prefetch(Int n) const {
+    assert(std::ranges::contains(this->UpperIndices(), n));
+    if constexpr (std::same_as<Evaluation, Lazy>) LazyTable(n);
+  }
+
+  // Returns the number of workspaces, each holding FFT plans and work
+  // arrays, and of on-the-fly Wigner tables built for the transforms since
+  // the FFT block size was last set. Once each thread has carried out a
+  // transform of a given kind and degree, repeating it builds nothing.
+  std::size_t WorkspacesBuilt() const { return _workspaces->built; }
+
+  // Sets the number of threads used within transforms. The default of
+  // zero uses the OpenMP default. With stored Wigner values, and unless
+  // pipelined, the results do not depend on the number of threads. When
+  // the values are computed on the fly, each thread sums the coefficients
+  // over its own chunk of colatitudes, and the partial sums are then added
+  // in chunk order. The forward transforms therefore change by rounding
+  // with the number of threads.
+  void SetNumberOfThreads(int threads) {
+    assert(threads >= 0);
+    _threads = threads;
+  }
+
+  int NumberOfThreads() const {
+#ifdef _OPENMP
+    return _threads > 0 ? _threads : omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  // Sets the number of rows FFT'd together within transforms, generating
+  // wisdom for the new block size.
+  void SetFFTBlockSize(int blockSize, FFTWpp::Flag flag = FFTWpp::Measure) {
+    assert(blockSize > 0);
+    _blockSize = blockSize;
+    GenerateWisdom(flag);
+    _workspaces = std::make_shared<Workspaces>();
+  }
+
+  auto FFTBlockSize() const { return _blockSize; }
+
+  // Sets the numbers of degrees and of colatitudes within the tiles over
+  // which the Legendre stage of a transform is summed. A tile of
+  // coefficients is then reused for each colatitude of a tile while it
+  // stays in cache, as are the rows for the degrees of a tile. The default
+  // of zero chooses sizes from LegendreTileBytes.
+  void SetLegendreBlockSizes(Int degrees, Int coLatitudes) {
+    assert(degrees >= 0 && coLatitudes >= 0);
+    _degreeBlock = degrees;
+    _coLatitudeBlock = coLatitudes;
+  }
+
+  auto LegendreBlockSizes() const {
+    return std::pair(_degreeBlock, _coLatitudeBlock);
+  }
+
+  // Sets whether the stages of inverse transforms are pipelined, so that
+  // the rows for each tile of colatitudes are FFT'd once summed, while the
+  // next tiles are summed. Otherwise all rows are summed before any are
+  // FFT'd. The rows of all tiles are still held in the one buffer, rather
+  // than in scratch for two tiles used in turn. This is intended, as the
+  // rows are not reused across transforms, but pipelining therefore saves
+  // no memory.
+  void SetPipelined(bool pipelined) { _pipelined = pipelined; }
+
+  auto Pipelined() const { return _pipelined; }
+
+  // Returns the number of threads, the FFT block size, the Legendre tile
+  // sizes and whether stages are pipelined within transforms.
+  GridTuning Tuning() const {
+    return {NumberOfThreads(), _blockSize, _degreeBlock, _coLatitudeBlock,
+            _pipelined};
+  }
+
+  // Sets the values returned by Tuning, generating wisdom if the FFT
+  // block size changes.
+  void SetTuning(const GridTuning& tuning,
+                 FFTWpp::Flag flag = FFTWpp::Measure) {
+    SetNumberOfThreads(tuning.threads);
+    if (tuning.fftBlockSize != _blockSize) {
+      SetFFTBlockSize(tuning.fftBlockSize, flag);
+    }
+    SetLegendreBlockSizes(tuning.degreeBlock, tuning.coLatitudeBlock);
+    SetPipelined(tuning.pipelined);
+  }
+
+  // Chooses the number of threads, the FFT block size, the Legendre tile
+  // sizes and whether stages are pipelined by timing transforms using
+  // candidate values, in the way that FFTW's Measure chooses among plans.
+  // Up to the OpenMP default number of threads are tried. The choice is
+  // remembered for grids with the same parameters built later within the
+  // process.
+  void Autotune(FFTWpp::Flag flag = FFTWpp::Measure) {
+    auto name = TuningFileName();
+    auto tuning = Tunings::Find(name);
+    if (!tuning) {
+      tuning = MeasureTuning(flag);
+      Tunings::Insert(name, *tuning);
+    }
+    SetTuning(*tuning, flag);
+  }
+
+  // As above, but with the choice also read from or written to a file
+  // within the given directory, such as that used for a cache, so that
+  // later runs on the same machine need not time the transforms. The FFTW
+  // wisdom for the grid's precision is kept in the same directory, so
+  // that the plans chosen need not be timed again either.
+  void Autotune(const std::filesystem::path& directory,
+                FFTWpp::Flag flag = FFTWpp::Measure) {
+    auto name = TuningFileName();
+    auto wisdom = directory / WisdomFileName();
+    ReadWisdom(wisdom);
+    auto tuning = Tunings::Find(name);
+    if (!tuning) tuning = Tunings::Read(directory / name);
+    if (!tuning) {
+      tuning = MeasureTuning(flag);
+      Tunings::Write(directory / name, *tuning);
+    }
+    Tunings::Insert(name, *tuning);
+    SetTuning(*tuning, flag);
+    WriteWisdom(wisdom);
+  }
+
+  // Returns the name of the file holding the tuning for the grid's
+  // parameters and the OpenMP default number of threads.
+  std::string TuningFileName() const {
+#ifdef _OPENMP
+    const auto threads = omp_get_max_threads();
+#else
+    const auto threads = 1;
+#endif
+    auto name = CacheFileName();
+    name.resize(name.size() - 4);
+    return name + "_" + std::to_string(threads) + ".tune";
+  }
+
+  // Returns the name of the file holding FFTW wisdom for the grid's
+  // precision, which is shared by all grids of that precision.
+  std::string WisdomFileName() const {
+    return "GaussLegendreGrid_" + std::to_string(sizeof(Real)) + ".wisdom";
+  }
+
+  // Returns the name of the shared memory segment for the grid's
+  // parameters.
+  std::string SharedMemoryName(const SharedMemory& shared) const {
+    return "/" + shared.prefix + "_" + CacheFileName();
+  }
+
   //------------------------------------------------//
   //    Methods needed to inherit from GridBase     //
   //------------------------------------------------//
   auto MaxDegree() const { return _lMax; }
   auto MaxUpperIndex() const { return _nMax; }
 
+  auto SparseUpperIndices() const
+  requires std::same_as<NRange, Sparse>
+  {
+    return std::ranges::views::all(_upperIndices);
+  }
+
   auto CoLatitudes() const {
     return std::ranges::views::all(_quadPointer->Points());
   }
@@ -150,78 +555,136 @@ class GaussLegendreGrid
     const auto nPhi = this->NumberOfLongitudes();
     const auto scaleFactor = static_cast<Real>(2) * std::numbers::pi_v<Real> /
                              static_cast<Real>(nPhi);
+    const auto threads = NumberOfThreads();
+    const auto nStored = static_cast<Int>(NumberOfStoredCoLatitudes());
 
-    // Make the FFT plan.
-    auto [inSize, outSize] = FFTWpp::DataSize<Scalar, Complex>(nPhi);
-    auto inWork = FFTWpp::vector<Scalar>(inSize);
-    auto outWork = FFTWpp::vector<Complex>(outSize);
-    auto inView = FFTWpp::Ranges::View(inWork);
-    auto outView = FFTWpp::Ranges::View(outWork);
-    auto planFunction = [](auto in, auto out) {
-      if constexpr (ComplexFloatingPoint<Scalar>) {
-        return FFTWpp::Ranges::Plan(in, out, FFTWpp::WisdomOnly,
-                                    FFTWpp::Forward);
-      } else {
-        return FFTWpp::Ranges::Plan(in, out, FFTWpp::WisdomOnly);
-      }
+    // Buffer for the FFTs of all rows, held within the calling thread's
+    // workspace.
+    using ForwardWorkspace = Workspace<Scalar, Complex, true>;
+    auto caller = TakeWorkspace<ForwardWorkspace>();
+    auto& buffer = caller->rows;
+    const auto rowSize = FFTWpp::DataSize<Scalar, Complex>(nPhi).second;
+    buffer.resize(this->NumberOfCoLatitudes() * rowSize);
+    auto row = [&](Int i) {
+      return std::span(buffer).subspan(i * rowSize, rowSize);
     };
-    auto plan = planFunction(inView, outView);
-
-    // Loop over the colatitudes.
-    for (auto iTheta : this->CoLatitudeIndices()) {
-      // FFT the current data slice.
-      auto offset = iTheta * nPhi;
-      auto inStart = std::next(in.begin(), offset);
-      auto inFinish = std::next(inStart, nPhi);
-      if constexpr (std::ranges::output_range<InRange, Scalar>) {
-        auto inView = std::ranges::subrange(inStart, inFinish);
-        plan.Execute(inView, outView);
-      } else {
-        std::copy(inStart, inFinish, inWork.begin());
-        plan.Execute();
-      }
 
-      // Get the Wigner values and quadrature weight.
-      auto d = _wignerPointer->operator()(n, iTheta);
-      auto w = _quadPointer->W(iTheta) * scaleFactor;
-
-      // Loop over the spherical harmonic coefficients
-      auto outIter = out.begin();
-      auto wigIter = d.cbegin();
-      auto degrees = d.Degrees() | std::ranges::views::filter(
-                                       [lMax](auto l) { return l <= lMax; });
-
-      for (auto l : degrees) {
-        auto dl = d(l);
+    // FFT blocks of rows in parallel. For n = 0 with equatorial symmetry,
+    // each pair of rows is then folded into even and odd parts.
+#pragma omp parallel num_threads(threads)
+    {
+      auto lease = TakeWorkspace<ForwardWorkspace>();
+      auto& workspace = *lease;
+      auto blockFFT = [&](auto& plan, Int first, Int count) {
+        auto inStart = std::next(in.begin(), first * nPhi);
+        auto inFinish = std::next(inStart, count * nPhi);
+        auto outView = std::span(buffer).subspan(first * rowSize,
+                                                  count * rowSize);
+        if constexpr (std::ranges::output_range<InRange, Scalar>) {
+          auto inView = std::ranges::subrange(inStart, inFinish);
+          plan.Execute(inView, outView);
+        } else {
+          std::copy(inStart, inFinish, workspace.inWork.begin());
+          auto inView = std::span(workspace.inWork).first(count * nPhi);
+          plan.Execute(inView, outView);
+        }
+      };
+#pragma omp for schedule(static)
+      for (auto i = Int{0}; i < NumberOfRowBlocks(); i++) {
+        auto [first, count] = RowBlock(i);
+        if (count == _blockSize) {
+          blockFFT(workspace.blockPlan, first, count);
+        } else {
+          blockFFT(workspace.rowPlan, first, count);
+        }
+      }
+      if (std::same_as<Symmetry, Equatorial> && n == 0) {
+#pragma omp for schedule(static)
+        for (auto iTheta = Int{0}; iTheta < nStored; iTheta++) {
+          auto iReflected = static_cast<Int>(ReflectedCoLatitudeIndex(iTheta));
+          if (iReflected != iTheta) FoldRows(row(iTheta), row(iReflected));
+        }
+      }
+    }
 
-        if constexpr (ComplexFloatingPoint<Scalar>) {
-          auto workIter = std::prev(outWork.end(), l);
-          for (auto m : dl.NegativeOrders()) {
-            *outIter++ += *wigIter++ * *workIter++ * w;
-          }
-          workIter = outWork.begin();
-          for (auto m : dl.NonNegativeOrders()) {
-            *outIter++ += *wigIter++ * *workIter++ * w;
+    // Adds the contributions from the colatitudes first to last - 1 to
+    // the coefficients for degrees lMin to lMaxBlock, starting at outIter.
+    auto sum = [&](Int first, Int last, Int lMin, Int lMaxBlock,
+                   auto outIter) {
+      for (auto iTheta = first; iTheta < last; iTheta++) {
+        auto w = _quadPointer->W(iTheta) * scaleFactor;
+        WithWignerValues(lMaxBlock, n, iTheta, [&](auto d) {
+          if constexpr (std::same_as<Symmetry, Equatorial>) {
+            const auto iReflected =
+                static_cast<Int>(ReflectedCoLatitudeIndex(iTheta));
+            if (iReflected != iTheta) {
+              return ForwardLegendre<Scalar>(lMin, lMaxBlock, n, d,
+                                             row(iTheta), row(iReflected),
+                                             w, outIter);
+            }
           }
+          ForwardLegendre<Scalar>(lMin, lMaxBlock, d, row(iTheta), w,
+                                  outIter);
+        });
+      }
+    };
+
+    const auto nAbs = std::abs(n);
+    if constexpr (std::same_as<Evaluation, OnTheFly>) {
+      // The Wigner values for a colatitude are computed once, and so the
+      // colatitudes are split between threads that sum into their own
+      // coefficients. These are then added in a fixed order so that the
+      // result does not depend on the scheduling.
+      auto& partials = caller->partials;
+      const auto size = static_cast<Int>(out.size());
+      partials.assign((threads - 1) * size, Complex{0});
+#pragma omp parallel for num_threads(threads) schedule(static)
+      for (auto t = 0; t < threads; t++) {
+        auto first = nStored * t / threads;
+        auto last = nStored * (t + 1) / threads;
+        if (t == 0) {
+          sum(first, last, nAbs, lMax, out.begin());
         } else {
-          auto workIter = outWork.begin();
-          if constexpr (std::same_as<MRange, All>) {
-            std::advance(wigIter, l);
-          }
-          for (auto m : dl.NonNegativeOrders()) {
-            *outIter++ += *wigIter++ * *workIter++ * w;
-          }
+          sum(first, last, nAbs, lMax,
+              std::next(partials.begin(), (t - 1) * size));
         }
       }
-
-      if constexpr (ComplexFloatingPoint<Scalar>) {
-        // Zero the (_lMax,_lMax) coefficient.
-        if (lMax == _lMax) {
-          auto view = std::ranges::views::reverse(out);
-          view[0] = 0;
+      for (auto t = 1; t < threads; t++) {
+        auto partial = std::span(partials).subspan((t - 1) * size, size);
+        std::ranges::transform(out, partial, out.begin(), std::plus<>());
+      }
+    } else {
+      // The degrees are split into tiles, each summed by one thread over a
+      // tile of colatitudes at a time, so that the coefficients of the tile
+      // stay in cache. By default all colatitudes form one tile, the rows
+      // then being read once for each tile of degrees. Every coefficient
+      // is summed in the same order as for a single thread, and so the
+      // result is independent of the number of threads.
+      const auto& layout = CoefficientLayout<Scalar>();
+      const auto nDegrees = DegreesPerTile<Scalar>(lMax, n);
+      const auto nTiles = (lMax - nAbs + nDegrees) / nDegrees;
+      const auto nTheta =
+          _coLatitudeBlock > 0 ? std::min(_coLatitudeBlock, nStored) : nStored;
+#pragma omp parallel num_threads(threads)
+      for (auto first = Int{0}; first < nStored; first += nTheta) {
+        auto last = std::min(first + nTheta, nStored);
+#pragma omp for schedule(dynamic)
+        for (auto b = Int{0}; b < nTiles; b++) {
+          auto lMin = nAbs + b * nDegrees;
+          auto lMaxTile = std::min(lMin + nDegrees - 1, lMax);
+          sum(first, last, lMin, lMaxTile,
+              std::next(out.begin(), layout.DegreeOffset(n, lMin)));
         }
       }
     }
+
+    if constexpr (ComplexFloatingPoint<Scalar>) {
+      // Zero the (_lMax,_lMax) coefficient.
+      if (lMax == _lMax) {
+        auto view = std::ranges::views::reverse(out);
+        view[0] = 0;
+      }
+    }
   }
 
   //------------------------------------------------//
@@ -271,72 +734,511 @@ class GaussLegendreGrid
 
     // Precompute constants
     const auto nPhi = this->NumberOfLongitudes();
+    const auto threads = NumberOfThreads();
+    const auto nStored = static_cast<Int>(NumberOfStoredCoLatitudes());
 
-    // Make the FFT plan.
-    auto [inSize, outSize] = FFTWpp::DataSize<Complex, Scalar>(nPhi);
-    auto inWork = FFTWpp::vector<Complex>(inSize);
-    auto outWork = FFTWpp::vector<Scalar>(outSize);
-    auto inView = FFTWpp::Ranges::View(inWork);
-    auto outView = FFTWpp::Ranges::View(outWork);
-    auto planFunction = [](auto in, auto out) {
-      if constexpr (ComplexFloatingPoint<Scalar>) {
-        return FFTWpp::Ranges::Plan(in, out, FFTWpp::WisdomOnly,
-                                    FFTWpp::Backward);
-      } else {
-        return FFTWpp::Ranges::Plan(in, out, FFTWpp::WisdomOnly);
-      }
+    // Buffer for the rows of Legendre sums, held within the calling
+    // thread's workspace.
+    using InverseWorkspace = Workspace<Complex, Scalar, false>;
+    auto caller = TakeWorkspace<InverseWorkspace>();
+    auto& buffer = caller->rows;
+    const auto rowSize = FFTWpp::DataSize<Complex, Scalar>(nPhi).first;
+    buffer.resize(this->NumberOfCoLatitudes() * rowSize);
+    auto row = [&](Int i) {
+      return std::span(buffer).subspan(i * rowSize, rowSize);
     };
-    auto plan = planFunction(inView, outView);
 
-    // Loop over the colatitudes.
-    for (auto iTheta : this->CoLatitudeIndices()) {
-      std::ranges::for_each(inWork, [](auto& x) { return x = 0; });
+    // The colatitudes are independent, and so tiles of them are shared
+    // between threads that first sum the coefficients into the buffer, and
+    // then FFT blocks of its rows using their own plans. The rows of a tile
+    // are summed over tiles of degrees in turn, so that the coefficients
+    // of a tile of degrees stay in cache while used for each colatitude.
+    const auto& layout = CoefficientLayout<Scalar>();
+    const auto nAbs = std::abs(n);
+    const auto nDegrees = DegreesPerTile<Scalar>(lMax, n);
+    const auto nTheta = CoLatitudesPerTile(rowSize);
+    const auto nTiles = (nStored + nTheta - 1) / nTheta;
 
-      // Get the Wigner values.
-      auto d = _wignerPointer->operator()(n, iTheta);
+    // When pipelined, the tiles are summed in turn and their rows FFT'd as
+    // soon as they are ready, so that threads finishing a tile FFT those
+    // already summed while others sum the next. Each thread takes the
+    // next tile ready to FFT if there is one, and otherwise the next to
+    // sum. A single thread then FFTs the rows of a tile while they are
+    // still in cache. No thread waits for a tile to be summed. Once all
+    // have been taken, the threads meet at a barrier and then share the
+    // FFTs of the tiles that remain.
+    auto nextSum = std::atomic<Int>{0};
+    auto nextFFT = std::atomic<Int>{0};
+    auto summed = std::vector<std::atomic<bool>>(_pipelined ? nTiles : 0);
+#pragma omp parallel num_threads(threads)
+    {
+      auto lease = TakeWorkspace<InverseWorkspace>();
+      auto& workspace = *lease;
 
-      // Loop over the coefficients.
-      auto inIter = in.begin();
-      auto wigIter = d.begin();
-      auto degrees = d.Degrees() | std::ranges::views::filter(
-                                       [lMax](auto l) { return l <= lMax; });
-      for (auto l : degrees) {
-        auto dl = d(l);
-        if constexpr (ComplexFloatingPoint<Scalar>) {
-          auto workIter = std::prev(inWork.end(), l);
-          for (auto m : dl.NegativeOrders()) {
-            *workIter++ += *inIter++ * *wigIter++;
+      // Sums the coefficients at the stored colatitudes within the kth
+      // tile and their reflections.
+      auto sumTile = [&](Int k) {
+        auto first = k * nTheta;
+        auto last = std::min(first + nTheta, nStored);
+        for (auto iTheta = first; iTheta < last; iTheta++) {
+          std::ranges::fill(row(iTheta), Complex{0});
+          std::ranges::fill(row(ReflectedCoLatitudeIndex(iTheta)),
+                            Complex{0});
+        }
+        for (auto lMin = nAbs; lMin <= lMax; lMin += nDegrees) {
+          auto lMaxTile = std::min(lMin + nDegrees - 1, lMax);
+          auto inIter = std::next(in.begin(), layout.DegreeOffset(n, lMin));
+          for (auto iTheta = first; iTheta < last; iTheta++) {
+            auto iReflected =
+                static_cast<Int>(ReflectedCoLatitudeIndex(iTheta));
+            auto north = row(iTheta);
+            auto south = row(iReflected);
+            WithWignerValues(lMax, n, iTheta, [&](auto d) {
+              if constexpr (std::same_as<Symmetry, Equatorial>) {
+                if (iReflected != iTheta) {
+                  return InverseLegendre<Scalar>(lMin, lMaxTile, n, d,
+                                                 inIter, north, south);
+                }
+              }
+              InverseLegendre<Scalar>(lMin, lMaxTile, d, inIter, north);
+            });
           }
-          workIter = inWork.begin();
-          for (auto m : dl.NonNegativeOrders()) {
-            *workIter++ += *inIter++ * *wigIter++;
+        }
+        if (std::same_as<Symmetry, Equatorial> && n == 0) {
+          for (auto iTheta = first; iTheta < last; iTheta++) {
+            auto iReflected =
+                static_cast<Int>(ReflectedCoLatitudeIndex(iTheta));
+            auto north = row(iTheta);
+            auto south = row(iReflected);
+            if (iReflected != iTheta) UnfoldRows(north, south);
           }
-        } else {
-          auto workIter = inWork.begin();
-          if constexpr (std::same_as<MRange, All>) {
-            std::advance(wigIter, l);
+        }
+      };
+
+      // Perform FFTs to recover the field at the colatitudes.
+      auto blockFFT = [&](auto& plan, Int first, Int count) {
+        auto inView = std::span(buffer).subspan(first * rowSize,
+                                                 count * rowSize);
+        auto outStart = std::next(out.begin(), first * nPhi);
+        auto outFinish = std::next(outStart, count * nPhi);
+        plan.Execute(inView, std::ranges::subrange(outStart, outFinish));
+      };
+
+      // FFTs the rows from first to last - 1 in blocks, with any left over
+      // transformed singly.
+      auto fftRows = [&](Int first, Int last) {
+        for (; first + _blockSize <= last; first += _blockSize) {
+          blockFFT(workspace.blockPlan, first, _blockSize);
+        }
+        for (; first < last; first++) blockFFT(workspace.rowPlan, first, 1);
+      };
+
+      // FFTs the rows of the kth tile. The reflected rows follow on from
+      // one another, excluding any on the equator.
+      auto fftTile = [&](Int k) {
+        auto first = k * nTheta;
+        auto last = std::min(first + nTheta, nStored);
+        fftRows(first, last);
+        if constexpr (std::same_as<Symmetry, Equatorial>) {
+          auto southFirst = ReflectedCoLatitudeIndex(last - 1);
+          auto southLast = ReflectedCoLatitudeIndex(first);
+          fftRows(std::max(static_cast<Int>(southFirst), last),
+                  static_cast<Int>(southLast) + 1);
+        }
+      };
+
+      if (_pipelined) {
+        while (true) {
+          auto k = nextFFT.load();
+          if (k < nTiles && summed[k].load(std::memory_order_acquire)) {
+            if (nextFFT.compare_exchange_strong(k, k + 1)) fftTile(k);
+            continue;
           }
-          for (auto m : dl.NonNegativeOrders()) {
-            *workIter++ += *inIter++ * *wigIter++;
+          if (auto next = nextSum.fetch_add(1); next < nTiles) {
+            sumTile(next);
+            summed[next].store(true, std::memory_order_release);
+            continue;
+          }
+          break;
+        }
+#pragma omp barrier
+        for (auto k = nextFFT.fetch_add(1); k < nTiles;
+             k = nextFFT.fetch_add(1)) {
+          fftTile(k);
+        }
+      } else {
+#pragma omp for schedule(dynamic)
+        for (auto k = Int{0}; k < nTiles; k++) sumTile(k);
+
+#pragma omp for schedule(static)
+        for (auto i = Int{0}; i < NumberOfRowBlocks(); i++) {
+          auto [first, count] = RowBlock(i);
+          if (count == _blockSize) {
+            blockFFT(workspace.blockPlan, first, count);
+          } else {
+            blockFFT(workspace.rowPlan, first, count);
           }
         }
       }
+    }
+  }
+
+  //------------------------------------------------//
+  //            Batched transformations             //
+  //------------------------------------------------//
+
+  // Transforms a batch of fields with the same upper index, held one after
+  // another within in, storing their coefficients one after another within
+  // out. The FFT'd rows of the batch are held with the field index
+  // fastest, so that the Legendre stage for each block of orders is a
+  // matrix product in which each Wigner value is read once for the batch.
+  template <std::ranges::range InRange, std::ranges::range OutRange>
+  requires requires() {
+    requires(std::same_as<MRange, All> and
+             ComplexFloatingPoint<std::ranges::range_value_t<InRange>>) or
+                RealFloatingPoint<std::ranges::range_value_t<InRange>>;
+    requires std::ranges::random_access_range<InRange>;
+    requires std::same_as<RemoveComplex<std::ranges::range_value_t<InRange>>,
+                          Real>;
+    requires ComplexFloatingPoint<std::ranges::range_value_t<OutRange>>;
+    requires std::ranges::random_access_range<OutRange>;
+    requires std::ranges::output_range<OutRange,
+                                       std::ranges::range_value_t<OutRange>>;
+    requires std::same_as<RemoveComplex<std::ranges::range_value_t<OutRange>>,
+                          Real>;
+  }
+  void ForwardTransformations(Int lMax, Int n, InRange&& in,
+                              OutRange& out) const {
+    // Get scalar type for field.
+    using Scalar = std::ranges::range_value_t<InRange>;
+
+    // Check upper index is possible.
+    assert(std::ranges::contains(this->UpperIndices(), n));
+
+    // Check dimensions of ranges.
+    const auto fieldSize = static_cast<Int>(this->ComponentSize());
+    const auto& layout = CoefficientLayout<Scalar>();
+    const auto coefficientSize = CoefficientIndices<Scalar>(lMax, n).size();
+    assert(static_cast<Int>(in.size()) % fieldSize == 0);
+    const auto batch = static_cast<Int>(in.size()) / fieldSize;
+    assert(static_cast<Int>(out.size()) == batch * coefficientSize);
 
-      // Perform FFT to recover field at the colatitude.
-      auto offset = iTheta * nPhi;
-      auto outStart = std::next(out.begin(), offset);
-      auto outFinish = std::next(outStart, nPhi);
-      auto outView = std::ranges::subrange(outStart, outFinish);
-      plan.Execute(inView, outView);
+    // Deal with lMax = 0
+    if (lMax == 0) {
+      for (auto k : std::ranges::views::iota(Int{0}, batch)) {
+        auto field = Member(in, k, fieldSize);
+        auto coefficients = Member(out, k, coefficientSize);
+        ForwardTransformation(lMax, n, field, coefficients);
+      }
+      return;
+    }
+
+    // Pre compute some constants.
+    const auto nPhi = this->NumberOfLongitudes();
+    const auto scaleFactor = static_cast<Real>(2) * std::numbers::pi_v<Real> /
+                             static_cast<Real>(nPhi);
+    const auto threads = NumberOfThreads();
+    const auto nStored = static_cast<Int>(NumberOfStoredCoLatitudes());
+
+    // Buffers for the FFT'd rows and for the coefficients of the batch,
+    // both with the field index fastest.
+    using ForwardWorkspace = Workspace<Scalar, Complex, true>;
+    auto caller = TakeWorkspace<ForwardWorkspace>();
+    auto& callerWorkspace = *caller;
+    auto& rows = callerWorkspace.rows;
+    auto& coefficients = callerWorkspace.coefficients;
+    const auto rowSize = FFTWpp::DataSize<Scalar, Complex>(nPhi).second;
+    rows.resize(this->NumberOfCoLatitudes() * rowSize * batch);
+    coefficients.assign(coefficientSize * batch, Complex{0});
+    auto row = [&](Int i) {
+      return std::span(rows).subspan(i * rowSize * batch, rowSize * batch);
+    };
+
+#pragma omp parallel num_threads(threads)
+    {
+      auto lease = TakeWorkspace<ForwardWorkspace>();
+      auto& workspace = *lease;
+
+      // FFT each block of rows for all members of the batch, and then
+      // interleave them into the rows of the batch.
+      const auto nRowBlocks = NumberOfRowBlocks();
+      auto& blockRows = workspace.blockRows;
+      auto blockFFT = [&](auto& plan, Int first, Int count) {
+        const auto blockSize = count * rowSize;
+        blockRows.resize(batch * blockSize);
+        for (auto k = Int{0}; k < batch; k++) {
+          auto inStart = std::next(in.begin(), k * fieldSize + first * nPhi);
+          auto inFinish = std::next(inStart, count * nPhi);
+          auto outView = std::span(blockRows).subspan(k * blockSize, blockSize);
+          if constexpr (std::ranges::output_range<InRange, Scalar>) {
+            auto inView = std::ranges::subrange(inStart, inFinish);
+            plan.Execute(inView, outView);
+          } else {
+            std::copy(inStart, inFinish, workspace.inWork.begin());
+            auto inView = std::span(workspace.inWork).first(count * nPhi);
+            plan.Execute(inView, outView);
+          }
+        }
+        for (auto j = Int{0}; j < count; j++) {
+          auto batchRow = row(first + j);
+          auto blockRow = blockRows.begin() + j * rowSize;
+          for (auto i = Int{0}; i < rowSize; i++) {
+            for (auto k = Int{0}; k < batch; k++) {
+              batchRow[i * batch + k] = blockRow[k * blockSize + i];
+            }
+          }
+        }
+      };
+#pragma omp for schedule(static)
+      for (auto i = Int{0}; i < nRowBlocks; i++) {
+        auto [first, count] = RowBlock(i);
+        if (count == _blockSize) {
+          blockFFT(workspace.blockPlan, first, count);
+        } else {
+          blockFFT(workspace.rowPlan, first, count);
+        }
+      }
+
+      // Sum over the colatitudes for each block of orders, taking blocks
+      // of colatitudes at once. The blocks hold distinct coefficients and
+      // each is summed in the order of the colatitudes, so the result does
+      // not depend on the scheduling. The reflected colatitudes are summed
+      // directly rather than by folding the rows.
+      const auto nOrderBlocks = NumberOfOrderBlocks<Scalar>(lMax);
+      const auto nTheta = ColatitudeBlockSize();
+      auto& values = workspace.values;
+      auto& offsets = workspace.offsets;
+#pragma omp for schedule(dynamic)
+      for (auto b = Int{0}; b < nOrderBlocks; b++) {
+        auto [mMin, mMax] = OrderBlock<Scalar>(lMax, b);
+        for (auto iTheta0 = Int{0}; iTheta0 < nStored; iTheta0 += nTheta) {
+          auto count = std::min(nTheta, nStored - iTheta0);
+          WithWignerBlock(lMax, n, iTheta0, count, [&](auto wigner) {
+            for (auto l = MinDegree(n, mMin, mMax); l <= lMax; l++) {
+              ForEachOrderRun<Scalar>(l, mMin, mMax, [&](Int m0, Int size) {
+                values.resize(2 * count * size);
+                offsets.resize(2 * count);
+                auto column = Column(m0);
+                auto terms = Int{0};
+                for (auto t = Int{0}; t < count; t++) {
+                  auto iTheta = iTheta0 + t;
+                  auto iReflected =
+                      static_cast<Int>(ReflectedCoLatitudeIndex(iTheta));
+                  auto w = _quadPointer->W(iTheta) * scaleFactor;
+                  auto dl = wigner(t)(l);
+                  PackValues(dl, l, m0, size, w, false,
+                             values.data() + terms * size);
+                  offsets[terms++] = iTheta * rowSize + column;
+                  if (iReflected != iTheta) {
+                    auto sign = MinusOneToPower(l + n);
+                    PackValues(dl, l, m0, size, sign * w, true,
+                               values.data() + terms * size);
+                    offsets[terms++] = iReflected * rowSize + column;
+                  }
+                }
+                LegendreKernels::MultiplyAddTerms(
+                    size, batch, terms, values.data(), rows.data(),
+                    offsets.data(),
+                    coefficients.data() +
+                        layout.LocalIndex(n, l, m0) * batch,
+                    [](Int) { return Int{0}; });
+              });
+            }
+          });
+        }
+      }
+    }
+
+    // Add the coefficients into those for each field.
+    auto outStart = out.begin();
+    for (auto i = Int{0}; i < coefficientSize; i++) {
+      for (auto k = Int{0}; k < batch; k++) {
+        outStart[k * coefficientSize + i] += coefficients[i * batch + k];
+      }
+    }
+    if constexpr (ComplexFloatingPoint<Scalar>) {
+      // Zero the (_lMax,_lMax) coefficients.
+      if (lMax == _lMax) {
+        for (auto k = Int{1}; k <= batch; k++) {
+          outStart[k * coefficientSize - 1] = 0;
+        }
+      }
+    }
+  }
+
+  // Inverse transformation of a batch of coefficients with the same upper
+  // index, held one after another within in, storing the fields one after
+  // another within out.
+  template <std::ranges::range InRange, std::ranges::range OutRange>
+  requires requires() {
+    requires ComplexFloatingPoint<std::ranges::range_value_t<InRange>>;
+    requires std::ranges::random_access_range<InRange>;
+    requires std::same_as<RemoveComplex<std::ranges::range_value_t<InRange>>,
+                          Real>;
+    requires(std::same_as<MRange, All> and
+             ComplexFloatingPoint<std::ranges::range_value_t<OutRange>>) or
+                RealFloatingPoint<std::ranges::range_value_t<OutRange>>;
+    requires std::ranges::random_access_range<OutRange>;
+    requires std::ranges::output_range<OutRange,
+                                       std::ranges::range_value_t<OutRange>>;
+    requires std::same_as<RemoveComplex<std::ranges::range_value_t<OutRange>>,
+                          Real>;
+  }
+  void InverseTransformations(Int lMax, Int n, InRange&& in,
+                              OutRange& out) const {
+    // Get scalar type for field.
+    using Scalar = std::ranges::range_value_t<OutRange>;
+
+    // Check upper index is possible.
+    assert(std::ranges::contains(this->UpperIndices(), n));
+
+    // Check dimensions of ranges.
+    const auto fieldSize = static_cast<Int>(this->ComponentSize());
+    const auto& layout = CoefficientLayout<Scalar>();
+    const auto coefficientSize = CoefficientIndices<Scalar>(lMax, n).size();
+    assert(static_cast<Int>(in.size()) % coefficientSize == 0);
+    const auto batch = static_cast<Int>(in.size()) / coefficientSize;
+    assert(static_cast<Int>(out.size()) == batch * fieldSize);
+
+    // Deal with lMax = 0
+    if (lMax == 0) {
+      for (auto k : std::ranges::views::iota(Int{0}, batch)) {
+        auto coefficients = Member(in, k, coefficientSize);
+        auto field = Member(out, k, fieldSize);
+        InverseTransformation(lMax, n, coefficients, field);
+      }
+      return;
+    }
+
+    // Precompute constants
+    const auto nPhi = this->NumberOfLongitudes();
+    const auto threads = NumberOfThreads();
+    const auto nStored = static_cast<Int>(NumberOfStoredCoLatitudes());
+
+    // Buffers for the coefficients and for the rows of Legendre sums of
+    // the batch, both with the field index fastest.
+    using InverseWorkspace = Workspace<Complex, Scalar, false>;
+    auto caller = TakeWorkspace<InverseWorkspace>();
+    auto& callerWorkspace = *caller;
+    auto& rows = callerWorkspace.rows;
+    auto& coefficients = callerWorkspace.coefficients;
+    const auto rowSize = FFTWpp::DataSize<Complex, Scalar>(nPhi).first;
+    rows.assign(this->NumberOfCoLatitudes() * rowSize * batch, Complex{0});
+    coefficients.resize(coefficientSize * batch);
+    auto inStart = in.begin();
+    for (auto i = Int{0}; i < coefficientSize; i++) {
+      for (auto k = Int{0}; k < batch; k++) {
+        coefficients[i * batch + k] = inStart[k * coefficientSize + i];
+      }
+    }
+    auto row = [&](Int i) {
+      return std::span(rows).subspan(i * rowSize * batch, rowSize * batch);
+    };
+
+#pragma omp parallel num_threads(threads)
+    {
+      auto lease = TakeWorkspace<InverseWorkspace>();
+      auto& workspace = *lease;
+
+      // Sum the coefficients for each block of orders, which fill
+      // distinct columns of the rows, taking blocks of degrees at once.
+      // Within a block, terms are skipped for orders above their degree.
+      const auto nOrderBlocks = NumberOfOrderBlocks<Scalar>(lMax);
+      const auto nDegrees = DegreeBlockSize();
+      auto& values = workspace.values;
+      auto& offsets = workspace.offsets;
+#pragma omp for schedule(dynamic)
+      for (auto b = Int{0}; b < nOrderBlocks; b++) {
+        auto [mMin, mMax] = OrderBlock<Scalar>(lMax, b);
+        for (auto iTheta = Int{0}; iTheta < nStored; iTheta++) {
+          auto iReflected = static_cast<Int>(ReflectedCoLatitudeIndex(iTheta));
+          WithWignerValues(lMax, n, iTheta, [&](auto d) {
+            auto lMin = MinDegree(n, mMin, mMax);
+            for (auto l0 = lMin; l0 <= lMax; l0 += nDegrees) {
+              auto count = std::min(nDegrees, lMax - l0 + 1);
+              auto l1 = l0 + count - 1;
+              ForEachOrderRun<Scalar>(l1, mMin, mMax, [&](Int m0, Int size) {
+                values.resize(count * size);
+                offsets.resize(count);
+                auto first = [&](Int j) {
+                  return std::clamp(std::abs(m0 + j) - l0, Int{0}, count);
+                };
+                auto sum = [&](Int i, bool reflected) {
+                  for (auto s = Int{0}; s < count; s++) {
+                    auto l = l0 + s;
+                    auto sign = reflected ? MinusOneToPower(l + n) : Real{1};
+                    PackValues(d(l), l, m0, size, sign, reflected,
+                               values.data() + s * size);
+                    offsets[s] = layout.LocalIndex(n, l, m0);
+                  }
+                  auto y = rows.data() + (i * rowSize + Column(m0)) * batch;
+                  LegendreKernels::MultiplyAddTerms(
+                      size, batch, count, values.data(), coefficients.data(),
+                      offsets.data(), y, first);
+                };
+                sum(iTheta, false);
+                if (iReflected != iTheta) sum(iReflected, true);
+              });
+            }
+          });
+        }
+      }
+
+      // Gather each block of rows for all members of the batch, and then
+      // FFT them.
+      const auto nRowBlocks = NumberOfRowBlocks();
+      auto& blockRows = workspace.blockRows;
+      auto blockFFT = [&](auto& plan, Int first, Int count) {
+        const auto blockSize = count * rowSize;
+        blockRows.resize(batch * blockSize);
+        for (auto j = Int{0}; j < count; j++) {
+          auto batchRow = row(first + j);
+          auto blockRow = blockRows.begin() + j * rowSize;
+          for (auto i = Int{0}; i < rowSize; i++) {
+            for (auto k = Int{0}; k < batch; k++) {
+              blockRow[k * blockSize + i] = batchRow[i * batch + k];
+            }
+          }
+        }
+        for (auto k = Int{0}; k < batch; k++) {
+          auto inView = std::span(blockRows).subspan(k * blockSize, blockSize);
+          auto outStart = std::next(out.begin(), k * fieldSize + first * nPhi);
+          auto outFinish = std::next(outStart, count * nPhi);
+          plan.Execute(inView, std::ranges::subrange(outStart, outFinish));
+        }
+      };
+#pragma omp for schedule(static)
+      for (auto i = Int{0}; i < nRowBlocks; i++) {
+        auto [first, count] = RowBlock(i);
+        if (count == _blockSize) {
+          blockFFT(workspace.blockPlan, first, count);
+        } else {
+          blockFFT(workspace.rowPlan, first, count);
+        }
+      }
     }
   }
 
  private:
   Int _lMax;
+  std::vector<Int> _upperIndices;  // Sorted upper indices if sparse.
   Int _nMax;
 
+  // Layouts of the coefficients of complex and real fields. Their degree
+  // offsets serve every upper index and maximum degree.
+  GSHLayout<All> _complexLayout{_lMax, _lMax, 0, 0};
+  GSHLayout<NonNegative> _realLayout{_lMax, _lMax, 0, 0};
+
   std::shared_ptr<QuadType> _quadPointer;
-  std::shared_ptr<WignerType> _wignerPointer;
+  std::shared_ptr<const WignerType> _wignerPointer;
+  std::shared_ptr<LazyWigner> _lazyPointer;
+  std::shared_ptr<Workspaces> _workspaces = std::make_shared<Workspaces>();
+  // Settings of the transforms, whose defaults are those of GridTuning.
+  int _threads = GridTuning{}.threads;
+  Int _blockSize = GridTuning{}.fftBlockSize;
+  Int _degreeBlock = GridTuning{}.degreeBlock;
+  Int _coLatitudeBlock = GridTuning{}.coLatitudeBlock;
+  bool _pipelined = GridTuning{}.pipelined;
 
   template <RealOrComplexFloatingPoint Scalar>
   auto WorkSize() const {
@@ -346,6 +1248,958 @@ class GaussLegendreGrid
       return 2 * _lMax;
     }
   }
+
+  void CheckInputs() const {
+    assert(MaxDegree() >= 0);
+    assert(MaxUpperIndex() <= MaxDegree());
+    assert(std::abs(this->MinUpperIndex()) <= MaxDegree());
+  }
+
+  // Get the quadrature points. In single precision these are computed in
+  // double precision and then rounded. The quadrature and Wigner values
+  // are shared through a registry with other grids of the same type and
+  // parameters that are alive within the process.
+  void ComputeQuadrature() {
+    _quadPointer = Registry<QuadType>::Get({_lMax}, [this]() {
+      using QuadReal =
+          std::conditional_t<std::same_as<Real, float>, double, Real>;
+      auto quad = GaussQuad::LegendrePolynomial<QuadReal>{}.GaussQuadrature(
+          _lMax + 1);
+
+      quad.Transform([](auto x) { return std::acos(-x); },
+                     [](auto x) -> QuadReal { return 1; });
+
+      if constexpr (std::same_as<QuadReal, Real>) {
+        return std::make_shared<QuadType>(std::move(quad));
+      } else {
+        auto points =
+            std::vector<Real>(quad.Points().begin(), quad.Points().end());
+        auto weights =
+            std::vector<Real>(quad.Weights().begin(), quad.Weights().end());
+        return std::make_shared<QuadType>(points, weights);
+      }
+    });
+  }
+
+  //  Get the Winger values. When evaluated on the fly, these are
+  //  instead computed one colatitude at a time within the transforms,
+  //  while lazy evaluation only sets up storage for the tables built on
+  //  first use. With equatorial symmetry only the northern colatitudes
+  //  are needed.
+  void ComputeWigner() {
+    if constexpr (std::same_as<Evaluation, Lazy>) {
+      _lazyPointer = Registry<LazyWigner>::Get(CacheKey(), [this]() {
+        return std::make_shared<LazyWigner>(this->UpperIndices().size());
+      });
+    }
+    if constexpr (std::same_as<Evaluation, Precomputed>) {
+      _wignerPointer = Registry<WignerType>::Get(CacheKey(), [this]() {
+        auto points = _quadPointer->Points();
+        points.resize(NumberOfStoredCoLatitudes());
+        if constexpr (std::same_as<NRange, Sparse>) {
+          return std::make_shared<WignerType>(_lMax, _lMax, _upperIndices,
+                                              points);
+        } else {
+          return std::make_shared<WignerType>(_lMax, _lMax, _nMax, points);
+        }
+      });
+    }
+  }
+
+  // Generate wisdom for FFTs, made for unaligned data as are the plans.
+  void GenerateWisdom(FFTWpp::Flag flag) const {
+    flag = flag | FFTWpp::Unaligned;
+    if (_lMax > 0) {
+      auto nPhi = this->NumberOfLongitudes();
+      auto layout = [](int size, int blockSize) {
+        return FFTWpp::Ranges::Layout(1, std::vector{size}, blockSize,
+                                      std::vector{size}, 1, size);
+      };
+      for (auto blockSize : {1, static_cast<int>(_blockSize)}) {
+        auto in = layout(nPhi, blockSize);
+        {
+          // Real to complex case.
+          auto out = layout(nPhi / 2 + 1, blockSize);
+          FFTWpp::GenerateWisdom<Real, Complex>(in, out, flag);
+        }
+        {
+          // Complex to complex case.
+          auto out = layout(nPhi, blockSize);
+          FFTWpp::GenerateWisdom<Complex, Complex>(in, out, flag);
+        }
+      }
+    }
+  }
+
+  // Reads FFTW wisdom for the grid's precision from a file, adding it to
+  // that already held. Returns false if the file could not be read.
+  static bool ReadWisdom(const std::filesystem::path& path) {
+    if constexpr (std::same_as<Real, float>) {
+      return fftwf_import_wisdom_from_filename(path.c_str()) != 0;
+    } else if constexpr (std::same_as<Real, double>) {
+      return fftw_import_wisdom_from_filename(path.c_str()) != 0;
+    } else {
+      return fftwl_import_wisdom_from_filename(path.c_str()) != 0;
+    }
+  }
+
+  // Writes all FFTW wisdom held for the grid's precision to a file. As
+  // for caches, a temporary file is written and then renamed. Returns
+  // false if the file could not be written.
+  static bool WriteWisdom(const std::filesystem::path& path) {
+    auto temporary = path;
+    temporary += ".tmp" + std::to_string(::getpid());
+    auto written = [&]() {
+      if constexpr (std::same_as<Real, float>) {
+        return fftwf_export_wisdom_to_filename(temporary.c_str()) != 0;
+      } else if constexpr (std::same_as<Real, double>) {
+        return fftw_export_wisdom_to_filename(temporary.c_str()) != 0;
+      } else {
+        return fftwl_export_wisdom_to_filename(temporary.c_str()) != 0;
+      }
+    }();
+    auto error = std::error_code{};
+    if (written) std::filesystem::rename(temporary, path, error);
+    if (!written || error) std::filesystem::remove(temporary, error);
+    return written && !error;
+  }
+
+  // Parameters identifying the values stored within a cache file.
+  auto CacheKey() const {
+    auto id = [](auto range) -> std::int64_t {
+      using Range = decltype(range);
+      if constexpr (std::same_as<Range, All>) {
+        return 0;
+      } else if constexpr (std::same_as<Range, NonNegative>) {
+        return 1;
+      } else if constexpr (std::same_as<Range, Sparse>) {
+        return 3;
+      } else {
+        return 2;
+      }
+    };
+    auto evaluation = []() -> std::int64_t {
+      if constexpr (std::same_as<Evaluation, Precomputed>) {
+        return 1;
+      } else if constexpr (std::same_as<Evaluation, OnTheFly>) {
+        return 0;
+      } else {
+        return 2;
+      }
+    }();
+    auto key = Cache::Key{
+        Cache::Type<Real>(),
+        Cache::Type<WignerReal>(),
+        _lMax,
+        _nMax,
+        id(MRange{}),
+        id(NRange{}),
+        id(NStorage{}),
+        static_cast<std::int64_t>(NumberOfStoredCoLatitudes(_lMax + 1)),
+        evaluation};
+    key.insert(key.end(), _upperIndices.begin(), _upperIndices.end());
+    return key;
+  }
+
+  // Gets the values from a cache file, or computes them and writes the
+  // file if no matching one is found.
+  void UseCache(const std::filesystem::path& path) {
+    if (!ReadValues(Cache::Read(path, CacheKey()))) {
+      ComputeQuadrature();
+      ComputeWigner();
+      WriteValues([&](const auto& key, CacheArrays arrays) {
+        return Cache::Write(path, key, arrays);
+      });
+    }
+  }
+
+  // Gets the values from a shared memory segment. The process creating
+  // the segment writes its values there and then drops its own copy. If
+  // the segment cannot be used, the values are computed locally. A
+  // segment whose creator died before completing it is removed and then
+  // created again.
+  void UseSharedMemory(const SharedMemory& shared) {
+    auto name = SharedMemoryName(shared);
+    for (auto attempt = 0; attempt < 3; attempt++) {
+      if (SharedSegment::Create(name)) {
+        ComputeQuadrature();
+        ComputeWigner();
+        auto written = WriteValues([&](const auto& key, CacheArrays arrays) {
+          return Cache::WriteShared(name, key, arrays);
+        });
+        if (!written) {
+          SharedSegment::Remove(name);
+          return;
+        }
+        _quadPointer.reset();
+        _wignerPointer.reset();
+        _lazyPointer.reset();
+      }
+      if (ReadValues(Cache::ReadShared(name, CacheKey(), shared.timeout))) {
+        return;
+      }
+      // Try again only if a segment orphaned by its creator was removed.
+      if (SharedSegment::Exists(name)) break;
+    }
+    ComputeQuadrature();
+    ComputeWigner();
+  }
+
+  // Sets the quadrature and Wigner values from the mapping and arrays
+  // returned when reading a cache, returning false if none were found or
+  // if any array does not have the expected size.
+  template <typename Mapping>
+  bool ReadValues(const Cache::Contents<Mapping>& cache) {
+    auto& [file, arrays] = cache;
+    constexpr auto nArrays = std::same_as<Evaluation, Precomputed> ? 3 : 2;
+    if (!file || arrays.size() != nArrays) return false;
+
+    auto hasSize = [&](auto i, std::size_t size, std::size_t bytes) {
+      return arrays[i].size() == size * bytes;
+    };
+    const auto nPoints = static_cast<std::size_t>(_lMax + 1);
+    if (!hasSize(0, nPoints, sizeof(Real)) ||
+        !hasSize(1, nPoints, sizeof(Real))) {
+      return false;
+    }
+    if constexpr (std::same_as<Evaluation, Precomputed>) {
+      auto size = StoredWignerSize(NumberOfStoredCoLatitudes(nPoints));
+      if (!hasSize(2, size, sizeof(WignerReal))) return false;
+    }
+
+    _quadPointer = Registry<QuadType>::Get({_lMax}, [&]() {
+      auto points = Cache::As<Real>(arrays[0]);
+      auto weights = Cache::As<Real>(arrays[1]);
+      return std::make_shared<QuadType>(
+          std::vector<Real>(points.begin(), points.end()),
+          std::vector<Real>(weights.begin(), weights.end()));
+    });
+
+    if constexpr (std::same_as<Evaluation, Precomputed>) {
+      _wignerPointer = Registry<WignerType>::Get(CacheKey(), [&]() {
+        auto values = Cache::As<const WignerReal>(arrays[2]);
+        if constexpr (std::same_as<NRange, Sparse>) {
+          return std::make_shared<WignerType>(_lMax, _lMax, _upperIndices,
+                                              NumberOfStoredCoLatitudes(),
+                                              values, file);
+        } else {
+          return std::make_shared<WignerType>(
+              _lMax, _lMax, _nMax, NumberOfStoredCoLatitudes(), values, file);
+        }
+      });
+    } else {
+      ComputeWigner();
+    }
+    return true;
+  }
+
+  // Returns the number of Wigner values stored at the given number of
+  // colatitudes, as laid out in the table.
+  std::size_t StoredWignerSize(std::size_t nTheta) const {
+    auto layout = [&]() {
+      if constexpr (std::same_as<NStorage, NRange>) {
+        return GSHLayout<MRange>(_lMax, _lMax, this->UpperIndices());
+      } else {
+        return GSHLayout<MRange>(_lMax, _lMax, Int{0}, _nMax);
+      }
+    }();
+    return layout.size() * nTheta;
+  }
+
+  // Passes the key and the quadrature and Wigner values to the given
+  // function for writing. Failure to write is not an error, as the values
+  // are simply recomputed next time.
+  using CacheArrays = std::initializer_list<std::span<const std::byte>>;
+
+  template <typename Write>
+  bool WriteValues(Write write) const {
+    auto points = std::as_bytes(std::span(_quadPointer->Points()));
+    auto weights = std::as_bytes(std::span(_quadPointer->Weights()));
+    if constexpr (std::same_as<Evaluation, Precomputed>) {
+      auto values = std::as_bytes(
+          std::span(_wignerPointer->begin(), _wignerPointer->end()));
+      return write(CacheKey(), {points, weights, values});
+    } else {
+      return write(CacheKey(), {points, weights});
+    }
+  }
+
+  // Returns the number of colatitudes at which Wigner values are needed.
+  auto NumberOfStoredCoLatitudes(std::size_t nTheta) const {
+    if constexpr (std::same_as<Symmetry, Equatorial>) {
+      return (nTheta + 1) / 2;
+    } else {
+      return nTheta;
+    }
+  }
+
+  auto NumberOfStoredCoLatitudes() const {
+    return NumberOfStoredCoLatitudes(this->NumberOfCoLatitudes());
+  }
+
+  auto StoredCoLatitudeIndices() const {
+    return std::ranges::views::iota(std::size_t{0},
+                                    NumberOfStoredCoLatitudes());
+  }
+
+  // Returns the index of the colatitude pi - theta when equatorial
+  // symmetry is used, and otherwise the input index.
+  auto ReflectedCoLatitudeIndex(std::size_t iTheta) const {
+    if constexpr (std::same_as<Symmetry, Equatorial>) {
+      return this->NumberOfCoLatitudes() - 1 - iTheta;
+    } else {
+      return iTheta;
+    }
+  }
+
+  // Rows are FFT'd in blocks of _blockSize consecutive colatitudes, with
+  // any left over transformed singly. Returns the number of such blocks.
+  Int NumberOfRowBlocks() const {
+    auto nTheta = static_cast<Int>(this->NumberOfCoLatitudes());
+    return nTheta / _blockSize + nTheta % _blockSize;
+  }
+
+  // Returns the first row and number of rows within the ith block.
+  std::pair<Int, Int> RowBlock(Int i) const {
+    auto nBlocks = static_cast<Int>(this->NumberOfCoLatitudes()) / _blockSize;
+    if (i < nBlocks) return {i * _blockSize, _blockSize};
+    return {nBlocks * _blockSize + i - nBlocks, 1};
+  }
+
+  // Returns the indices of the coefficients for a field of the given type.
+  template <RealOrComplexFloatingPoint Scalar>
+  static auto CoefficientIndices(Int lMax, Int n) {
+    return GSHIndices<
+        std::conditional_t<RealFloatingPoint<Scalar>, NonNegative, All>>(
+        lMax, lMax, n);
+  }
+
+  // Returns the tabulated layout of the coefficients for a field of the
+  // given type, used for lookups within the transforms.
+  template <RealOrComplexFloatingPoint Scalar>
+  const auto& CoefficientLayout() const {
+    if constexpr (RealFloatingPoint<Scalar>) {
+      return _realLayout;
+    } else {
+      return _complexLayout;
+    }
+  }
+
+  // Size in bytes targeted for the coefficients within a tile of degrees
+  // and for the rows within a tile of colatitudes, so that both stay
+  // within a typical L2 cache.
+  static constexpr std::size_t LegendreTileBytes = std::size_t{1} << 19;
+
+  // Returns the number of degrees within each tile of the Legendre stage.
+  // With Wigner values computed on the fly, all degrees are found
+  // together for a colatitude, and so they form a single tile.
+  template <RealOrComplexFloatingPoint Scalar>
+  Int DegreesPerTile(Int lMax, Int n) const {
+    const auto nDegrees = lMax - std::abs(n) + 1;
+    if constexpr (std::same_as<Evaluation, OnTheFly>) {
+      return nDegrees;
+    } else {
+      if (_degreeBlock > 0) return std::min(_degreeBlock, nDegrees);
+      const auto nOrders =
+          RealFloatingPoint<Scalar> ? lMax + 1 : 2 * lMax + 1;
+      auto degrees =
+          static_cast<Int>(LegendreTileBytes / (nOrders * sizeof(Complex)));
+      if (const auto threads = Int{NumberOfThreads()}; threads > 1) {
+        // Leave a few tiles for each thread to balance the load.
+        degrees = std::min(degrees, (nDegrees + 4 * threads - 1) /
+                                        (4 * threads));
+      }
+      return std::clamp(degrees, Int{1}, nDegrees);
+    }
+  }
+
+  // Returns the number of colatitudes within each tile of the Legendre
+  // stage of inverse transforms, leaving at least one tile per thread.
+  Int CoLatitudesPerTile(Int rowSize) const {
+    const auto nStored = static_cast<Int>(NumberOfStoredCoLatitudes());
+    if (_coLatitudeBlock > 0) return std::min(_coLatitudeBlock, nStored);
+    const auto threads = Int{NumberOfThreads()};
+    auto count =
+        static_cast<Int>(LegendreTileBytes / (2 * rowSize * sizeof(Complex)));
+    return std::clamp(count, Int{1}, (nStored + threads - 1) / threads);
+  }
+
+  // Times an inverse and forward transform of a random field for each
+  // candidate tuning, changing one setting at a time while keeping the
+  // best found for the others, and leaves the grid with the fastest. The
+  // field has the upper index of least magnitude, and is real if only
+  // non-negative orders are stored.
+  GridTuning MeasureTuning(FFTWpp::Flag flag) {
+    using Scalar = std::conditional_t<std::same_as<MRange, All>, Complex, Real>;
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+    if (_lMax == 0) return Tuning();
+
+    const auto n = std::ranges::min(this->UpperIndices(), {},
+                                    [](auto n) { return std::abs(n); });
+    auto flm = FFTWpp::vector<Complex>(
+        CoefficientIndices<Scalar>(_lMax, n).size());
+    if constexpr (RealFloatingPoint<Scalar>) {
+      this->RandomRealCoefficient(_lMax, n, flm);
+    } else {
+      this->RandomComplexCoefficient(_lMax, n, flm);
+    }
+    auto f = FFTWpp::vector<Scalar>(this->ComponentSize());
+    auto glm = FFTWpp::vector<Complex>(flm.size());
+
+    // Takes the least of a few timings after one made to set up the work
+    // arrays for the current settings.
+    auto time = [&]() {
+      auto best = std::numeric_limits<double>::max();
+      for (auto i = 0; i < 4; i++) {
+        auto start = Clock::now();
+        InverseTransformation(_lMax, n, flm, f);
+        ForwardTransformation(_lMax, n, f, glm);
+        if (i > 0) best = std::min(best, Seconds(Clock::now() - start).count());
+      }
+      return best;
+    };
+
+    auto best = Tuning();
+    auto bestTime = time();
+    auto consider = [&](GridTuning tuning) {
+      if (tuning == best) return;
+      SetTuning(tuning, flag);
+      if (auto seconds = time(); seconds < bestTime) {
+        best = tuning;
+        bestTime = seconds;
+      }
+    };
+
+#ifdef _OPENMP
+    const auto maxThreads = omp_get_max_threads();
+    auto threadCounts = std::vector{maxThreads};
+    for (auto threads = 1; threads < maxThreads; threads *= 2) {
+      threadCounts.push_back(threads);
+    }
+    for (auto threads : threadCounts) {
+      consider({threads, best.fftBlockSize, best.degreeBlock,
+                best.coLatitudeBlock, best.pipelined});
+    }
+#endif
+
+    const auto nTheta = static_cast<Int>(this->NumberOfCoLatitudes());
+    for (auto blockSize : {Int{1}, Int{4}, Int{16}, Int{64}}) {
+      if (blockSize > nTheta) break;
+      consider({best.threads, blockSize, best.degreeBlock,
+                best.coLatitudeBlock, best.pipelined});
+    }
+
+    // Tiles either side of the default sizes, along with a single tile of
+    // degrees and single colatitudes as used without tiling.
+    if constexpr (!std::same_as<Evaluation, OnTheFly>) {
+      SetTuning(best, flag);
+      const auto degrees = DegreesPerTile<Scalar>(_lMax, n);
+      for (auto degreeBlock : {degrees / 2, 2 * degrees, _lMax + 1}) {
+        if (degreeBlock == 0) continue;
+        consider({best.threads, best.fftBlockSize, degreeBlock,
+                  best.coLatitudeBlock, best.pipelined});
+      }
+    }
+    const auto rowSize =
+        FFTWpp::DataSize<Scalar, Complex>(this->NumberOfLongitudes()).second;
+    SetTuning(best, flag);
+    const auto coLatitudes = CoLatitudesPerTile(rowSize);
+    for (auto coLatitudeBlock : {Int{1}, coLatitudes / 2, 2 * coLatitudes}) {
+      if (coLatitudeBlock == 0) continue;
+      consider({best.threads, best.fftBlockSize, best.degreeBlock,
+                coLatitudeBlock, best.pipelined});
+    }
+    consider({best.threads, best.fftBlockSize, best.degreeBlock,
+              best.coLatitudeBlock, !best.pipelined});
+
+    SetTuning(best, flag);
+    return best;
+  }
+
+  // Returns the kth member of a batch held within range.
+  static auto Member(auto& range, Int k, Int size) {
+    auto start = std::next(range.begin(), k * size);
+    return std::ranges::subrange(start, std::next(start, size));
+  }
+
+  // Within batched transforms the orders are split into a few blocks for
+  // each thread, these being taken dynamically as they involve differing
+  // numbers of degrees. Each block reads the Wigner values for its orders
+  // in turn. With Wigner values computed on the fly, these are computed
+  // once for each block, and so there is only one block per thread.
+  static constexpr Int OrderBlocksPerThread = 4;
+
+  template <RealOrComplexFloatingPoint Scalar>
+  Int OrderBlockWidth(Int lMax) const {
+    const auto nOrders =
+        RealFloatingPoint<Scalar> ? lMax + 1 : 2 * lMax + 1;
+    auto nBlocks = static_cast<Int>(NumberOfThreads());
+    if constexpr (!std::same_as<Evaluation, OnTheFly>) {
+      nBlocks *= OrderBlocksPerThread;
+    }
+    return (nOrders + nBlocks - 1) / nBlocks;
+  }
+
+  template <RealOrComplexFloatingPoint Scalar>
+  Int NumberOfOrderBlocks(Int lMax) const {
+    const auto nOrders =
+        RealFloatingPoint<Scalar> ? lMax + 1 : 2 * lMax + 1;
+    const auto width = OrderBlockWidth<Scalar>(lMax);
+    return (nOrders + width - 1) / width;
+  }
+
+  // Returns the least and greatest orders within the bth block.
+  template <RealOrComplexFloatingPoint Scalar>
+  std::pair<Int, Int> OrderBlock(Int lMax, Int b) const {
+    const auto mMin = RealFloatingPoint<Scalar> ? Int{0} : -lMax;
+    const auto width = OrderBlockWidth<Scalar>(lMax);
+    return {mMin + b * width, std::min(mMin + (b + 1) * width - 1, lMax)};
+  }
+
+  // Number of colatitudes summed at once within forward batched
+  // transforms, and of degrees within inverse ones. With Wigner values
+  // computed on the fly, those for each colatitude of a block are held
+  // together, and so colatitudes are then taken one at a time.
+  static constexpr Int BatchTerms = 8;
+
+  static constexpr Int ColatitudeBlockSize() {
+    return std::same_as<Evaluation, OnTheFly> ? 1 : BatchTerms;
+  }
+
+  static constexpr Int DegreeBlockSize() { return BatchTerms; }
+
+  // Returns the least degree with orders from mMin to mMax.
+  static Int MinDegree(Int n, Int mMin, Int mMax) {
+    return std::max(std::abs(n),
+                    mMin > 0 ? mMin : (mMax < 0 ? -mMax : Int{0}));
+  }
+
+  // Returns the position of order m within an FFT'd row.
+  Int Column(Int m) const {
+    return m < 0 ? static_cast<Int>(this->NumberOfLongitudes()) + m : m;
+  }
+
+  // Calls f(m0, size) for the runs of orders from max(mMin, -l) to
+  // min(mMax, l), split at m = 0 so that each is contiguous within the
+  // FFT'd rows. Only non-negative orders are used for real fields.
+  template <RealOrComplexFloatingPoint Scalar>
+  static void ForEachOrderRun(Int l, Int mMin, Int mMax, auto f) {
+    auto first = std::max(mMin, RealFloatingPoint<Scalar> ? Int{0} : -l);
+    auto last = std::min(mMax, l);
+    if (first > last) return;
+    if (first < 0) f(first, std::min(last, Int{-1}) - first + 1);
+    if (last >= 0) {
+      auto start = std::max(first, Int{0});
+      f(start, last - start + 1);
+    }
+  }
+
+  // Stores c d(l, m0 + j) in a[j] for 0 <= j < size, or c d(l, -m0 - j)
+  // if reflected, skipping the entries for orders greater than l.
+  static void PackValues(auto dl, Int l, Int m0, Int size, Real c,
+                         bool reflected, Real* a) {
+    auto jFirst = std::max(Int{0}, -l - m0);
+    auto jLast = std::min(size - 1, l - m0);
+    auto start = dl.begin();
+    if (reflected) {
+      auto offset = -m0 - dl.MinOrder();
+      for (auto j = jFirst; j <= jLast; j++) {
+        a[j] = c * Value(start[offset - j]);
+      }
+    } else {
+      auto offset = m0 - dl.MinOrder();
+      for (auto j = jFirst; j <= jLast; j++) {
+        a[j] = c * Value(start[offset + j]);
+      }
+    }
+  }
+
+  // Calls the function with f(t) returning the Wigner values for upper
+  // index n at stored colatitude iTheta + t for 0 <= t < count.
+  template <typename Function>
+  void WithWignerBlock(Int lMax, Int n, Int iTheta, Int count,
+                       Function f) const {
+    if constexpr (std::same_as<Evaluation, OnTheFly>) {
+      auto lease = TakeWorkspace<RowWigners>();
+      auto& wigners = lease->wigners[UpperIndexPosition(n)];
+      for (auto t = Int{0}; t < count; t++) {
+        auto theta = this->CoLatitudes()[iTheta + t];
+        SetRowWigner(wigners, t, lMax, n, theta);
+      }
+      f([&](Int t) { return wigners[t](n, 0); });
+    } else if constexpr (std::same_as<Evaluation, Lazy>) {
+      auto& table = LazyTable(n);
+      f([&](Int t) { return table(n, iTheta + t); });
+    } else {
+      f([&](Int t) { return _wignerPointer->operator()(n, iTheta + t); });
+    }
+  }
+
+  // Takes a workspace of the given type from the pool, making one if none
+  // is free. Each thread within a transform holds one until the transform
+  // ends, and so no more are made than are ever in use at once, while
+  // later transforms neither plan nor allocate.
+  template <typename W>
+  Lease<W> TakeWorkspace() const {
+    auto lock = std::lock_guard(_workspaces->mutex);
+    auto& pool = std::get<Pool<W>>(_workspaces->pools);
+    auto workspace = std::unique_ptr<W>{};
+    if (pool.free.empty()) {
+      if constexpr (std::same_as<W, RowWigners>) {
+        workspace = std::make_unique<W>();
+        workspace->wigners.resize(this->UpperIndices().size());
+      } else {
+        workspace =
+            std::make_unique<W>(this->NumberOfLongitudes(), _blockSize);
+      }
+      pool.free.reserve(++pool.made);
+      _workspaces->built++;
+    } else {
+      workspace = std::move(pool.free.back());
+      pool.free.pop_back();
+    }
+    return Lease<W>(_workspaces, std::move(workspace));
+  }
+
+  // Sets the tth of the Wigner values for transforms computing them on the
+  // fly to those for degrees up to lMax and upper index n at colatitude
+  // theta, computing them in place if the degree is unchanged.
+  void SetRowWigner(std::vector<RowWignerType>& wigners, Int t, Int lMax,
+                    Int n, Real theta) const {
+    if (t == static_cast<Int>(wigners.size())) {
+      wigners.emplace_back(lMax, lMax, n, theta);
+      _workspaces->built++;
+    } else if (wigners[t].MaxDegree() != lMax) {
+      wigners[t] = RowWignerType(lMax, lMax, n, theta);
+      _workspaces->built++;
+    } else {
+      wigners[t].Recompute(theta);
+    }
+  }
+
+  // Calls the function with the Wigner values for upper index n at the
+  // given stored colatitude, computing them first if needed.
+  template <typename Function>
+  void WithWignerValues(Int lMax, Int n, std::size_t iTheta,
+                        Function f) const {
+    if constexpr (std::same_as<Evaluation, OnTheFly>) {
+      auto lease = TakeWorkspace<RowWigners>();
+      auto& wigners = lease->wigners[UpperIndexPosition(n)];
+      SetRowWigner(wigners, 0, lMax, n, this->CoLatitudes()[iTheta]);
+      f(wigners[0](n, 0));
+    } else if constexpr (std::same_as<Evaluation, Lazy>) {
+      f(LazyTable(n)(n, iTheta));
+    } else {
+      f(_wignerPointer->operator()(n, iTheta));
+    }
+  }
+
+  // Returns the position of upper index n within those of the grid.
+  Int UpperIndexPosition(Int n) const {
+    auto upperIndices = this->UpperIndices();
+    return std::ranges::distance(std::ranges::begin(upperIndices),
+                                 std::ranges::lower_bound(upperIndices, n));
+  }
+
+  // Returns the lazily built table for upper index n. Concurrent callers
+  // wait for a single thread to build it.
+  LazyWignerType& LazyTable(Int n) const {
+    auto i = UpperIndexPosition(n);
+    auto& table = _lazyPointer->tables[i];
+    std::call_once(_lazyPointer->flags[i], [&]() {
+      auto points = _quadPointer->Points();
+      points.resize(NumberOfStoredCoLatitudes());
+      table = std::make_unique<LazyWignerType>(_lMax, _lMax, n, points);
+    });
+    return *table;
+  }
+
+  // Adds the contribution from a single colatitude to the coefficients
+  // for degrees lMin to lMax, starting at outIter, given the Wigner
+  // values, d, and the FFT of the field, work, at that colatitude. The
+  // quadrature weight, w, includes the longitude spacing.
+  template <RealOrComplexFloatingPoint Scalar>
+  void ForwardLegendre(Int lMin, Int lMax, auto d, const auto& work, Real w,
+                       auto outIter) const {
+    for (auto l : std::ranges::views::iota(lMin, lMax + 1)) {
+      ForwardLegendreDegree<Scalar>(l, d(l), work, w, outIter);
+    }
+  }
+
+  // As above, but adding in the contributions from a colatitude and its
+  // reflection in the equator. Using d^{l}_{mn}(pi - theta) =
+  // (-1)^{l+n} d^{l}_{-m,n}(theta), both are obtained from a single pass
+  // through the northern Wigner values. For n = 0 this relation reduces
+  // to d^{l}_{m0}(pi - theta) = (-1)^{l+m} d^{l}_{m0}(theta), and the
+  // rows must have been folded into even and odd parts so that each value
+  // is used in a single multiply-add.
+  template <RealOrComplexFloatingPoint Scalar>
+  void ForwardLegendre(Int lMin, Int lMax, Int n, auto d, const auto& north,
+                       const auto& south, Real w, auto outIter) const {
+    auto degrees = std::ranges::views::iota(lMin, lMax + 1);
+    if (n == 0) {
+      for (auto l : degrees) {
+        const auto& work = l % 2 ? south : north;
+        ForwardLegendreDegree<Scalar>(l, d(l), work, w, outIter);
+      }
+    } else {
+      for (auto l : degrees) {
+        auto sign = MinusOneToPower(l + n);
+        ForwardLegendreDegree<Scalar>(l, d(l), north, south, sign, w,
+                                      outIter);
+      }
+    }
+  }
+
+  template <RealOrComplexFloatingPoint Scalar>
+  void ForwardLegendreDegree(Int l, auto dl, const auto& work, Real w,
+                             auto& outIter) const {
+    if constexpr (UseKernels<decltype(dl), decltype(outIter)>) {
+      auto [d, nNegative, nNonNegative] = KernelValues(dl);
+      auto out = std::to_address(outIter);
+      if constexpr (ComplexFloatingPoint<Scalar>) {
+        LegendreKernels::MultiplyAdd(nNegative, w, d,
+                                     work.data() + work.size() - nNegative,
+                                     out);
+        out += nNegative;
+      }
+      LegendreKernels::MultiplyAdd(nNonNegative, w, d + nNegative,
+                                   work.data(), out);
+      outIter += out + nNonNegative - std::to_address(outIter);
+      return;
+    }
+    auto wigIter = dl.begin();
+    if constexpr (ComplexFloatingPoint<Scalar>) {
+      auto workIter = std::prev(work.end(), l);
+      for (auto m : dl.NegativeOrders()) {
+        *outIter++ += Value(*wigIter++) * *workIter++ * w;
+      }
+      workIter = work.begin();
+      for (auto m : dl.NonNegativeOrders()) {
+        *outIter++ += Value(*wigIter++) * *workIter++ * w;
+      }
+    } else {
+      auto workIter = work.begin();
+      if constexpr (std::same_as<MRange, All>) {
+        std::ranges::advance(wigIter, l);
+      }
+      for (auto m : dl.NonNegativeOrders()) {
+        *outIter++ += Value(*wigIter++) * *workIter++ * w;
+      }
+    }
+  }
+
+  template <RealOrComplexFloatingPoint Scalar>
+  void ForwardLegendreDegree(Int l, auto dl, const auto& north,
+                             const auto& south, Real sign, Real w,
+                             auto& outIter) const {
+    if constexpr (UseKernels<decltype(dl), decltype(outIter)>) {
+      auto [d, nNegative, nNonNegative] = KernelValues(dl);
+      auto dr = d + nNegative + nNonNegative - 1;
+      auto out = std::to_address(outIter);
+      if constexpr (ComplexFloatingPoint<Scalar>) {
+        auto offset = north.size() - nNegative;
+        LegendreKernels::MultiplyAddPair(nNegative, w, d, sign * w, dr,
+                                         north.data() + offset,
+                                         south.data() + offset, out);
+        out += nNegative;
+      }
+      LegendreKernels::MultiplyAddPair(nNonNegative, w, d + nNegative,
+                                       sign * w, dr - nNegative,
+                                       north.data(), south.data(), out);
+      outIter += out + nNonNegative - std::to_address(outIter);
+      return;
+    }
+    // Iterators to the values for orders m and -m, respectively.
+    auto wigIter = dl.begin();
+    auto wigReverseIter = std::make_reverse_iterator(dl.end());
+    if constexpr (ComplexFloatingPoint<Scalar>) {
+      auto northIter = std::prev(north.end(), l);
+      auto southIter = std::prev(south.end(), l);
+      for (auto m : dl.NegativeOrders()) {
+        *outIter++ += (Value(*wigIter++) * *northIter++ +
+                       sign * Value(*wigReverseIter++) * *southIter++) *
+                      w;
+      }
+      northIter = north.begin();
+      southIter = south.begin();
+      for (auto m : dl.NonNegativeOrders()) {
+        *outIter++ += (Value(*wigIter++) * *northIter++ +
+                       sign * Value(*wigReverseIter++) * *southIter++) *
+                      w;
+      }
+    } else {
+      auto northIter = north.begin();
+      auto southIter = south.begin();
+      std::ranges::advance(wigIter, l);
+      std::ranges::advance(wigReverseIter, l);
+      for (auto m : dl.NonNegativeOrders()) {
+        *outIter++ += (Value(*wigIter++) * *northIter++ +
+                       sign * Value(*wigReverseIter++) * *southIter++) *
+                      w;
+      }
+    }
+  }
+
+  // Adds the coefficients for degrees lMin to lMax, starting at inIter,
+  // summed at a single colatitude given the Wigner values, d, to the FFT
+  // work array.
+  template <RealOrComplexFloatingPoint Scalar>
+  void InverseLegendre(Int lMin, Int lMax, auto d, auto inIter,
+                       auto& work) const {
+    for (auto l : std::ranges::views::iota(lMin, lMax + 1)) {
+      InverseLegendreDegree<Scalar>(l, d(l), inIter, work);
+    }
+  }
+
+  // As above, but summing the coefficients at a colatitude and its
+  // reflection in the equator. For n = 0 the even and odd degrees are
+  // summed separately, and the rows must be unfolded once all degrees
+  // have been added.
+  template <RealOrComplexFloatingPoint Scalar>
+  void InverseLegendre(Int lMin, Int lMax, Int n, auto d, auto inIter,
+                       auto& north, auto& south) const {
+    auto degrees = std::ranges::views::iota(lMin, lMax + 1);
+    if (n == 0) {
+      for (auto l : degrees) {
+        auto& work = l % 2 ? south : north;
+        InverseLegendreDegree<Scalar>(l, d(l), inIter, work);
+      }
+    } else {
+      for (auto l : degrees) {
+        auto sign = MinusOneToPower(l + n);
+        InverseLegendreDegree<Scalar>(l, d(l), inIter, north, south, sign);
+      }
+    }
+  }
+
+  template <RealOrComplexFloatingPoint Scalar>
+  void InverseLegendreDegree(Int l, auto dl, auto& inIter, auto& work) const {
+    if constexpr (UseKernels<decltype(dl), decltype(inIter)>) {
+      auto [d, nNegative, nNonNegative] = KernelValues(dl);
+      auto in = std::to_address(inIter);
+      if constexpr (ComplexFloatingPoint<Scalar>) {
+        LegendreKernels::MultiplyAdd(nNegative, Real{1}, d, in,
+                                     work.data() + work.size() - nNegative);
+        in += nNegative;
+      }
+      LegendreKernels::MultiplyAdd(nNonNegative, Real{1}, d + nNegative, in,
+                                   work.data());
+      inIter += in + nNonNegative - std::to_address(inIter);
+      return;
+    }
+    auto wigIter = dl.begin();
+    if constexpr (ComplexFloatingPoint<Scalar>) {
+      auto workIter = std::prev(work.end(), l);
+      for (auto m : dl.NegativeOrders()) {
+        *workIter++ += *inIter++ * Value(*wigIter++);
+      }
+      workIter = work.begin();
+      for (auto m : dl.NonNegativeOrders()) {
+        *workIter++ += *inIter++ * Value(*wigIter++);
+      }
+    } else {
+      auto workIter = work.begin();
+      if constexpr (std::same_as<MRange, All>) {
+        std::ranges::advance(wigIter, l);
+      }
+      for (auto m : dl.NonNegativeOrders()) {
+        *workIter++ += *inIter++ * Value(*wigIter++);
+      }
+    }
+  }
+
+  template <RealOrComplexFloatingPoint Scalar>
+  void InverseLegendreDegree(Int l, auto dl, auto& inIter, auto& north,
+                             auto& south, Real sign) const {
+    if constexpr (UseKernels<decltype(dl), decltype(inIter)>) {
+      auto [d, nNegative, nNonNegative] = KernelValues(dl);
+      auto dr = d + nNegative + nNonNegative - 1;
+      auto in = std::to_address(inIter);
+      if constexpr (ComplexFloatingPoint<Scalar>) {
+        auto offset = north.size() - nNegative;
+        LegendreKernels::MultiplyAddSplit(nNegative, Real{1}, d, sign, dr, in,
+                                          north.data() + offset,
+                                          south.data() + offset);
+        in += nNegative;
+      }
+      LegendreKernels::MultiplyAddSplit(nNonNegative, Real{1}, d + nNegative,
+                                        sign, dr - nNegative, in,
+                                        north.data(), south.data());
+      inIter += in + nNonNegative - std::to_address(inIter);
+      return;
+    }
+    // Iterators to the values for orders m and -m, respectively.
+    auto wigIter = dl.begin();
+    auto wigReverseIter = std::make_reverse_iterator(dl.end());
+    auto sum = [&](auto& northIter, auto& southIter) {
+      const auto f = *inIter++;
+      *northIter++ += f * Value(*wigIter++);
+      *southIter++ += sign * f * Value(*wigReverseIter++);
+    };
+    if constexpr (ComplexFloatingPoint<Scalar>) {
+      auto northIter = std::prev(north.end(), l);
+      auto southIter = std::prev(south.end(), l);
+      for (auto m : dl.NegativeOrders()) sum(northIter, southIter);
+      northIter = north.begin();
+      southIter = south.begin();
+      for (auto m : dl.NonNegativeOrders()) sum(northIter, southIter);
+    } else {
+      auto northIter = north.begin();
+      auto southIter = south.begin();
+      std::ranges::advance(wigIter, l);
+      std::ranges::advance(wigReverseIter, l);
+      for (auto m : dl.NonNegativeOrders()) sum(northIter, southIter);
+    }
+  }
+
+  // Maps a pair of FFT'd rows (a, b) to (a + (-1)^m b, a - (-1)^m b). The
+  // order, m, at a given position has the parity of the index because
+  // the number of longitudes is even.
+  static void FoldRows(auto a, auto b) {
+    auto sign = Real{1};
+    for (auto i : std::ranges::views::iota(std::size_t{0}, a.size())) {
+      auto sum = a[i] + sign * b[i];
+      b[i] = a[i] - sign * b[i];
+      a[i] = sum;
+      sign = -sign;
+    }
+  }
+
+  // Maps the sums over even and odd degrees, (a, b), to the rows
+  // (a + b, (-1)^m (a - b)). This is the transpose of FoldRows.
+  static void UnfoldRows(auto& a, auto& b) {
+    auto sign = Real{1};
+    for (auto i : std::ranges::views::iota(std::size_t{0}, a.size())) {
+      auto sum = a[i] + b[i];
+      b[i] = sign * (a[i] - b[i]);
+      a[i] = sum;
+      sign = -sign;
+    }
+  }
+
+  static constexpr Real MinusOneToPower(Int m) { return m % 2 ? -1 : 1; }
+
+  // The kernels in LegendreKernels.h are used when the Wigner values for a
+  // degree and the coefficients are held contiguously. Otherwise, as for
+  // values reflected from those of -n, the loops below are used.
+  template <typename Values, typename Iter>
+  static constexpr bool UseKernels =
+      std::ranges::contiguous_range<Values> and
+      std::contiguous_iterator<std::remove_cvref_t<Iter>>;
+
+  // Returns a pointer to the Wigner values for a degree along with the
+  // numbers of negative and non-negative orders.
+  static auto KernelValues(auto& dl) {
+    auto d = std::to_address(dl.begin());
+    auto nNegative = -dl.MinOrder();
+    auto nNonNegative = dl.MaxOrder() + 1;
+    return std::tuple(d, nNegative, nNonNegative);
+  }
+
+  // Converts a stored Wigner value to the precision of the grid.
+  static Real Value(auto d) { return static_cast<Real>(d); }
 };
 
 }  // namespace GSHTrans
@@ -25,11 +25,21 @@ class GridBase {
     if constexpr (std::same_as<NRange, Single>) {
       return _Derived().MaxUpperIndex();
     }
+    if constexpr (std::same_as<NRange, Sparse>) {
+      return _Derived().SparseUpperIndices().front();
+    }
   }
 
+  // Returns the upper indices in increasing order. For a sparse set these
+  // are supplied by the derived class.
   auto UpperIndices() const {
-    return std::ranges::views::iota(MinUpperIndex(),
-                                    _Derived().MaxUpperIndex() + 1);
+    using NRange = Derived::NRange_type;
+    if constexpr (std::same_as<NRange, Sparse>) {
+      return _Derived().SparseUpperIndices();
+    } else {
+      return std::ranges::views::iota(MinUpperIndex(),
+                                      _Derived().MaxUpperIndex() + 1);
+    }
   }
 
   auto NumberOfCoLatitudes() const { return _Derived().CoLatitudes().size(); }
@@ -7,6 +7,8 @@
 #include <numeric>
 #include <random>
 #include <ranges>
+#include <span>
+#include <vector>
 
 #include "Concepts.h"
 
@@ -145,6 +147,99 @@ class GSHIndices {
   Int _n;
 };
 
+// Layout of values for a sorted set of upper indices, stored one after
+// another with the values for each following the order of GSHIndices.
+// Offsets are tabulated on construction so that lookups are table reads.
+// Degree offsets depend on n only through the first degree, |n|, and so a
+// single table serves all upper indices.
+template <OrderIndexRange MRange>
+class GSHLayout {
+  using Int = std::ptrdiff_t;
+
+ public:
+  GSHLayout() = default;
+  GSHLayout(Int lMax, Int mMax, Int nMin, Int nMax)
+      : GSHLayout(lMax, mMax, std::ranges::views::iota(nMin, nMax + 1)) {}
+
+  // Upper indices within the range of the set but not in it take no
+  // storage.
+  template <std::ranges::forward_range Range>
+  requires std::integral<std::ranges::range_value_t<Range>>
+  GSHLayout(Int lMax, Int mMax, Range&& upperIndices)
+      : _mMax{std::min(lMax, mMax)} {
+    assert(!std::ranges::empty(upperIndices));
+    assert(std::ranges::is_sorted(upperIndices));
+    assert(std::ranges::adjacent_find(upperIndices) ==
+           std::ranges::end(upperIndices));
+    auto offset = Int{0};
+    for (auto l = Int{0}; l <= lMax; l++) {
+      _degreeOffsets.push_back(offset);
+      offset += GSHSubIndices<MRange>(l, mMax).size();
+    }
+    _degreeOffsets.push_back(offset);
+    _nMin = *std::ranges::begin(upperIndices);
+    offset = 0;
+    auto next = _nMin;
+    for (Int n : upperIndices) {
+      assert(std::abs(n) <= lMax);
+      for (; next <= n; next++) _upperOffsets.push_back(offset);
+      offset += _degreeOffsets.back() - _degreeOffsets[std::abs(n)];
+    }
+    _upperOffsets.push_back(offset);
+  }
+
+  // Total number of values.
+  auto size() const { return _upperOffsets.back(); }
+
+  // Offset and number of the values for upper index n.
+  auto Offset(Int n) const { return _upperOffsets[n - _nMin]; }
+  auto Size(Int n) const {
+    return _upperOffsets[n - _nMin + 1] - _upperOffsets[n - _nMin];
+  }
+
+  // Offsets of each degree when counted from degree zero. The offset of
+  // degree l within the values for n is found by subtracting that of |n|.
+  auto DegreeOffsets() const { return std::span(_degreeOffsets); }
+
+  // Offset of degree l within the values for upper index n. This does not
+  // depend on the offset of n, and so holds for any n of magnitude no
+  // greater than the maximum degree.
+  auto DegreeOffset(Int n, Int l) const {
+    return _degreeOffsets[l] - _degreeOffsets[std::abs(n)];
+  }
+
+  // Index of (l,m) within the values for upper index n, which again holds
+  // for any n.
+  auto LocalIndex(Int n, Int l, Int m) const {
+    if constexpr (std::same_as<MRange, All>) {
+      return DegreeOffset(n, l) + m + std::min(l, _mMax);
+    } else {
+      return DegreeOffset(n, l) + m;
+    }
+  }
+
+  auto Index(Int n, Int l, Int m) const {
+    return Offset(n) + LocalIndex(n, l, m);
+  }
+
+ private:
+  Int _mMax = 0;
+  Int _nMin = 0;
+  std::vector<Int> _degreeOffsets;
+  std::vector<Int> _upperOffsets;
+};
+
+// Returns a set of upper indices sorted into increasing order with any
+// repeats removed.
+inline std::vector<std::ptrdiff_t> SortedUpperIndices(
+    std::vector<std::ptrdiff_t> upperIndices) {
+  assert(!upperIndices.empty());
+  std::ranges::sort(upperIndices);
+  auto [first, last] = std::ranges::unique(upperIndices);
+  upperIndices.erase(first, last);
+  return upperIndices;
+}
+
 }  // namespace GSHTrans
 
 #endif  // GSH_TRANS_INDEXING_GUARD_H
\ No newline at end of file
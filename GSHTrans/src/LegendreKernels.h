@@ -0,0 +1,369 @@
+#ifndef GSH_TRANS_LEGENDRE_KERNELS_GUARD_H
+#define GSH_TRANS_LEGENDRE_KERNELS_GUARD_H
+
+#include <complex>
+#include <concepts>
+#include <cstddef>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+namespace GSHTrans {
+
+namespace LegendreKernels {
+
+// Multiply-add loops for the Legendre stage of the transforms, in which a
+// complex row is scaled by real Wigner values. The complex arrays are
+// accessed as interleaved real and imaginary parts so that each forms a
+// stream of real fused multiply-adds, rather than complex products that
+// the compiler will not vectorise. Scale factors such as quadrature
+// weights are applied once to each Wigner value. The arrays must not
+// overlap.
+//
+// When compiled for AVX-512 or for AVX2 with FMA, the kernels are written
+// with intrinsics, and the loops in Fallback, which the compiler is left
+// to vectorise, handle the remaining elements and any other instruction
+// set.
+
+namespace Fallback {
+
+// y[k] += c d[k] x[k] for 0 <= k < size.
+template <std::floating_point Real, std::floating_point Value>
+void MultiplyAdd(std::ptrdiff_t size, Real c, const Value* d,
+                 const std::complex<Real>* x, std::complex<Real>* y) {
+  auto xr = reinterpret_cast<const Real*>(x);
+  auto yr = reinterpret_cast<Real*>(y);
+#pragma omp simd
+  for (std::ptrdiff_t k = 0; k < size; k++) {
+    auto a = c * static_cast<Real>(d[k]);
+    yr[2 * k] += a * xr[2 * k];
+    yr[2 * k + 1] += a * xr[2 * k + 1];
+  }
+}
+
+// y[k] += c d[k] x[k] + cr dr[-k] z[k] for 0 <= k < size, where dr points
+// to Wigner values read in reverse order.
+template <std::floating_point Real, std::floating_point Value>
+void MultiplyAddPair(std::ptrdiff_t size, Real c, const Value* d, Real cr,
+                     const Value* dr, const std::complex<Real>* x,
+                     const std::complex<Real>* z, std::complex<Real>* y) {
+  auto xr = reinterpret_cast<const Real*>(x);
+  auto zr = reinterpret_cast<const Real*>(z);
+  auto yr = reinterpret_cast<Real*>(y);
+#pragma omp simd
+  for (std::ptrdiff_t k = 0; k < size; k++) {
+    auto a = c * static_cast<Real>(d[k]);
+    auto b = cr * static_cast<Real>(dr[-k]);
+    yr[2 * k] += a * xr[2 * k] + b * zr[2 * k];
+    yr[2 * k + 1] += a * xr[2 * k + 1] + b * zr[2 * k + 1];
+  }
+}
+
+// y[k] += c d[k] x[k] and z[k] += cr dr[-k] x[k] for 0 <= k < size, the
+// transpose of MultiplyAddPair.
+template <std::floating_point Real, std::floating_point Value>
+void MultiplyAddSplit(std::ptrdiff_t size, Real c, const Value* d, Real cr,
+                      const Value* dr, const std::complex<Real>* x,
+                      std::complex<Real>* y, std::complex<Real>* z) {
+  auto xr = reinterpret_cast<const Real*>(x);
+  auto yr = reinterpret_cast<Real*>(y);
+  auto zr = reinterpret_cast<Real*>(z);
+#pragma omp simd
+  for (std::ptrdiff_t k = 0; k < size; k++) {
+    auto a = c * static_cast<Real>(d[k]);
+    auto b = cr * static_cast<Real>(dr[-k]);
+    yr[2 * k] += a * xr[2 * k];
+    yr[2 * k + 1] += a * xr[2 * k + 1];
+    zr[2 * k] += b * xr[2 * k];
+    zr[2 * k + 1] += b * xr[2 * k + 1];
+  }
+}
+
+// Kernel for batches of rows held with the batch index fastest, so that
+// the value for order j of the kth member is at j * batch + k. The sum
+//
+//   y[j, k] += sum_s a[s * size + j] x[(offset[s] + j) * batch + k],
+//
+// is taken over first(j) <= s < terms for 0 <= j < size. In the forward
+// transform the terms are colatitudes, and in the inverse transform they
+// are degrees, so that the first terms are skipped for orders greater
+// than their degrees. The loops run over j and then over s, adding
+// c = a[s * size + j] times the run of x for offset[s] + j to the run of
+// y for j through memory, with the innermost loop over the batch.
+template <std::floating_point Real, typename First>
+void MultiplyAddTerms(std::ptrdiff_t size, std::ptrdiff_t batch,
+                      std::ptrdiff_t terms, const Real* a,
+                      const std::complex<Real>* x,
+                      const std::ptrdiff_t* offset, std::complex<Real>* y,
+                      First first) {
+  auto xr = reinterpret_cast<const Real*>(x);
+  auto yr = reinterpret_cast<Real*>(y);
+  const auto stride = 2 * batch;
+  for (std::ptrdiff_t j = 0; j < size; j++) {
+    auto yj = yr + j * stride;
+    for (auto s = first(j); s < terms; s++) {
+      auto c = a[s * size + j];
+      auto xs = xr + (offset[s] + j) * stride;
+#pragma omp simd
+      for (std::ptrdiff_t k = 0; k < stride; k++) yj[k] += c * xs[k];
+    }
+  }
+}
+
+}  // namespace Fallback
+
+// Registers of real values for the intrinsic kernels. Each holds the real
+// and imaginary parts of Complexes consecutive complex values. Repeat
+// loads that many Wigner values from d, d + 1, ..., and RepeatReversed
+// loads them from d, d - 1, ..., each value being placed against both
+// parts of its complex value.
+template <std::floating_point Real>
+struct Pack {};
+
+#if defined(__AVX512F__)
+
+template <>
+struct Pack<double> {
+  using Type = __m512d;
+  static constexpr std::ptrdiff_t Complexes = 4;
+
+  static Type Load(const double* p) { return _mm512_loadu_pd(p); }
+  static void Store(double* p, Type v) { _mm512_storeu_pd(p, v); }
+  static Type Set(double c) { return _mm512_set1_pd(c); }
+  static Type Mul(Type a, Type b) { return _mm512_mul_pd(a, b); }
+  static Type Add(Type a, Type b) { return _mm512_add_pd(a, b); }
+  static Type FMA(Type a, Type b, Type c) { return _mm512_fmadd_pd(a, b, c); }
+
+  static Type Repeat(const double* d) {
+    return Spread(_mm256_loadu_pd(d), _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0));
+  }
+  static Type Repeat(const float* d) {
+    return Spread(_mm256_cvtps_pd(_mm_loadu_ps(d)),
+                  _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0));
+  }
+  static Type RepeatReversed(const double* d) {
+    return Spread(_mm256_loadu_pd(d - 3),
+                  _mm512_set_epi64(0, 0, 1, 1, 2, 2, 3, 3));
+  }
+  static Type RepeatReversed(const float* d) {
+    return Spread(_mm256_cvtps_pd(_mm_loadu_ps(d - 3)),
+                  _mm512_set_epi64(0, 0, 1, 1, 2, 2, 3, 3));
+  }
+
+ private:
+  static Type Spread(__m256d values, __m512i index) {
+    return _mm512_permutexvar_pd(index, _mm512_castpd256_pd512(values));
+  }
+};
+
+template <>
+struct Pack<float> {
+  using Type = __m512;
+  static constexpr std::ptrdiff_t Complexes = 8;
+
+  static Type Load(const float* p) { return _mm512_loadu_ps(p); }
+  static void Store(float* p, Type v) { _mm512_storeu_ps(p, v); }
+  static Type Set(float c) { return _mm512_set1_ps(c); }
+  static Type Mul(Type a, Type b) { return _mm512_mul_ps(a, b); }
+  static Type Add(Type a, Type b) { return _mm512_add_ps(a, b); }
+  static Type FMA(Type a, Type b, Type c) { return _mm512_fmadd_ps(a, b, c); }
+
+  static Type Repeat(const float* d) {
+    return Spread(_mm256_loadu_ps(d),
+                  _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1,
+                                   0, 0));
+  }
+  static Type RepeatReversed(const float* d) {
+    return Spread(_mm256_loadu_ps(d - 7),
+                  _mm512_set_epi32(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                   7, 7));
+  }
+
+ private:
+  static Type Spread(__m256 values, __m512i index) {
+    return _mm512_permutexvar_ps(index, _mm512_castps256_ps512(values));
+  }
+};
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+template <>
+struct Pack<double> {
+  using Type = __m256d;
+  static constexpr std::ptrdiff_t Complexes = 2;
+
+  static Type Load(const double* p) { return _mm256_loadu_pd(p); }
+  static void Store(double* p, Type v) { _mm256_storeu_pd(p, v); }
+  static Type Set(double c) { return _mm256_set1_pd(c); }
+  static Type Mul(Type a, Type b) { return _mm256_mul_pd(a, b); }
+  static Type Add(Type a, Type b) { return _mm256_add_pd(a, b); }
+  static Type FMA(Type a, Type b, Type c) { return _mm256_fmadd_pd(a, b, c); }
+
+  static Type Repeat(const double* d) {
+    return Spread(_mm_loadu_pd(d));
+  }
+  static Type Repeat(const float* d) {
+    return Spread(_mm_cvtps_pd(_mm_castpd_ps(
+        _mm_load_sd(reinterpret_cast<const double*>(d)))));
+  }
+  static Type RepeatReversed(const double* d) {
+    return Spread(_mm_shuffle_pd(_mm_loadu_pd(d - 1), _mm_loadu_pd(d - 1),
+                                 1));
+  }
+  static Type RepeatReversed(const float* d) {
+    auto values = _mm_cvtps_pd(_mm_castpd_ps(
+        _mm_load_sd(reinterpret_cast<const double*>(d - 1))));
+    return Spread(_mm_shuffle_pd(values, values, 1));
+  }
+
+ private:
+  static Type Spread(__m128d values) {
+    return _mm256_permute4x64_pd(_mm256_castpd128_pd256(values), 0x50);
+  }
+};
+
+template <>
+struct Pack<float> {
+  using Type = __m256;
+  static constexpr std::ptrdiff_t Complexes = 4;
+
+  static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+  static void Store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+  static Type Set(float c) { return _mm256_set1_ps(c); }
+  static Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+  static Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+  static Type FMA(Type a, Type b, Type c) { return _mm256_fmadd_ps(a, b, c); }
+
+  static Type Repeat(const float* d) {
+    return Spread(_mm_loadu_ps(d), _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3));
+  }
+  static Type RepeatReversed(const float* d) {
+    return Spread(_mm_loadu_ps(d - 3),
+                  _mm256_setr_epi32(3, 3, 2, 2, 1, 1, 0, 0));
+  }
+
+ private:
+  static Type Spread(__m128 values, __m256i index) {
+    return _mm256_permutevar8x32_ps(_mm256_castps128_ps256(values), index);
+  }
+};
+
+#endif
+
+// True if there are intrinsic kernels for the given types.
+template <typename Real, typename Value>
+concept Vectorised = requires(const Value* d) {
+  Pack<Real>::Repeat(d);
+  Pack<Real>::RepeatReversed(d);
+};
+
+// y[k] += c d[k] x[k] for 0 <= k < size.
+template <std::floating_point Real, std::floating_point Value>
+void MultiplyAdd(std::ptrdiff_t size, Real c, const Value* d,
+                 const std::complex<Real>* x, std::complex<Real>* y) {
+  auto k = std::ptrdiff_t{0};
+  if constexpr (Vectorised<Real, Value>) {
+    using P = Pack<Real>;
+    auto xr = reinterpret_cast<const Real*>(x);
+    auto yr = reinterpret_cast<Real*>(y);
+    const auto cv = P::Set(c);
+    for (; k + P::Complexes <= size; k += P::Complexes) {
+      auto a = P::Mul(cv, P::Repeat(d + k));
+      auto i = 2 * k;
+      P::Store(yr + i, P::FMA(a, P::Load(xr + i), P::Load(yr + i)));
+    }
+  }
+  Fallback::MultiplyAdd(size - k, c, d + k, x + k, y + k);
+}
+
+// y[k] += c d[k] x[k] + cr dr[-k] z[k] for 0 <= k < size, where dr points
+// to Wigner values read in reverse order.
+template <std::floating_point Real, std::floating_point Value>
+void MultiplyAddPair(std::ptrdiff_t size, Real c, const Value* d, Real cr,
+                     const Value* dr, const std::complex<Real>* x,
+                     const std::complex<Real>* z, std::complex<Real>* y) {
+  auto k = std::ptrdiff_t{0};
+  if constexpr (Vectorised<Real, Value>) {
+    using P = Pack<Real>;
+    auto xr = reinterpret_cast<const Real*>(x);
+    auto zr = reinterpret_cast<const Real*>(z);
+    auto yr = reinterpret_cast<Real*>(y);
+    const auto cv = P::Set(c);
+    const auto crv = P::Set(cr);
+    for (; k + P::Complexes <= size; k += P::Complexes) {
+      auto a = P::Mul(cv, P::Repeat(d + k));
+      auto b = P::Mul(crv, P::RepeatReversed(dr - k));
+      auto i = 2 * k;
+      auto sum = P::FMA(b, P::Load(zr + i), P::Mul(a, P::Load(xr + i)));
+      P::Store(yr + i, P::Add(P::Load(yr + i), sum));
+    }
+  }
+  Fallback::MultiplyAddPair(size - k, c, d + k, cr, dr - k, x + k, z + k,
+                            y + k);
+}
+
+// y[k] += c d[k] x[k] and z[k] += cr dr[-k] x[k] for 0 <= k < size, the
+// transpose of MultiplyAddPair.
+template <std::floating_point Real, std::floating_point Value>
+void MultiplyAddSplit(std::ptrdiff_t size, Real c, const Value* d, Real cr,
+                      const Value* dr, const std::complex<Real>* x,
+                      std::complex<Real>* y, std::complex<Real>* z) {
+  auto k = std::ptrdiff_t{0};
+  if constexpr (Vectorised<Real, Value>) {
+    using P = Pack<Real>;
+    auto xr = reinterpret_cast<const Real*>(x);
+    auto yr = reinterpret_cast<Real*>(y);
+    auto zr = reinterpret_cast<Real*>(z);
+    const auto cv = P::Set(c);
+    const auto crv = P::Set(cr);
+    for (; k + P::Complexes <= size; k += P::Complexes) {
+      auto a = P::Mul(cv, P::Repeat(d + k));
+      auto b = P::Mul(crv, P::RepeatReversed(dr - k));
+      auto i = 2 * k;
+      auto xk = P::Load(xr + i);
+      P::Store(yr + i, P::FMA(a, xk, P::Load(yr + i)));
+      P::Store(zr + i, P::FMA(b, xk, P::Load(zr + i)));
+    }
+  }
+  Fallback::MultiplyAddSplit(size - k, c, d + k, cr, dr - k, x + k, y + k,
+                             z + k);
+}
+
+// Batched kernel, as described in Fallback, with the innermost loop over
+// the batch written with intrinsics.
+template <std::floating_point Real, typename First>
+void MultiplyAddTerms(std::ptrdiff_t size, std::ptrdiff_t batch,
+                      std::ptrdiff_t terms, const Real* a,
+                      const std::complex<Real>* x,
+                      const std::ptrdiff_t* offset, std::complex<Real>* y,
+                      First first) {
+  if constexpr (Vectorised<Real, Real>) {
+    using P = Pack<Real>;
+    auto xr = reinterpret_cast<const Real*>(x);
+    auto yr = reinterpret_cast<Real*>(y);
+    const auto stride = 2 * batch;
+    constexpr auto width = 2 * P::Complexes;
+    for (std::ptrdiff_t j = 0; j < size; j++) {
+      auto yj = yr + j * stride;
+      for (auto s = first(j); s < terms; s++) {
+        auto c = a[s * size + j];
+        auto cv = P::Set(c);
+        auto xs = xr + (offset[s] + j) * stride;
+        auto k = std::ptrdiff_t{0};
+        for (; k + width <= stride; k += width) {
+          P::Store(yj + k, P::FMA(cv, P::Load(xs + k), P::Load(yj + k)));
+        }
+        for (; k < stride; k++) yj[k] += c * xs[k];
+      }
+    }
+  } else {
+    Fallback::MultiplyAddTerms(size, batch, terms, a, x, offset, y, first);
+  }
+}
+
+}  // namespace LegendreKernels
+
+}  // namespace GSHTrans
+
+#endif  // GSH_TRANS_LEGENDRE_KERNELS_GUARD_H
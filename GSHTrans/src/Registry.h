@@ -0,0 +1,86 @@
+#ifndef GSH_TRANS_REGISTRY_GUARD_H
+#define GSH_TRANS_REGISTRY_GUARD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GSHTrans {
+
+// Process-wide table of objects of a given type that are shared between
+// all users asking for the same key. Only weak references are held, so an
+// object is freed once its last user goes away, and is built again if it
+// is later asked for.
+template <typename T>
+class Registry {
+  using Int = std::int64_t;
+
+ public:
+  using Key = std::vector<Int>;
+
+  // Returns the object for the key, calling make to build it if needed.
+  // Each key has its own lock held while its object is built, so that
+  // concurrent requests for the same key build it only once, while those
+  // for other keys go ahead. The registry itself is only locked to find
+  // the entry for a key.
+  template <typename Make>
+  static std::shared_ptr<T> Get(const Key& key, Make make) {
+    auto& [mutex, entries] = Instance();
+    auto slot = std::shared_ptr<Slot>{};
+    {
+      auto lock = std::lock_guard(mutex);
+      std::erase_if(entries, [](const auto& entry) {
+        return entry.second.use_count() == 1 && entry.second->object.expired();
+      });
+      auto& entry = entries[key];
+      if (!entry) entry = std::make_shared<Slot>();
+      if (auto pointer = entry->object.lock()) return pointer;
+      slot = entry;
+    }
+
+    auto build = std::lock_guard(slot->mutex);
+    {
+      auto lock = std::lock_guard(mutex);
+      if (auto pointer = slot->object.lock()) return pointer;
+    }
+    auto pointer = std::shared_ptr<T>(make());
+    auto lock = std::lock_guard(mutex);
+    slot->object = pointer;
+    return pointer;
+  }
+
+  // Returns the number of objects currently held by users.
+  static std::size_t size() {
+    auto& [mutex, entries] = Instance();
+    auto lock = std::lock_guard(mutex);
+    return std::ranges::count_if(entries, [](const auto& entry) {
+      return !entry.second->object.expired();
+    });
+  }
+
+ private:
+  // The object for a key and the lock held while building it. The object
+  // is only read or written with the registry locked.
+  struct Slot {
+    std::mutex mutex;
+    std::weak_ptr<T> object;
+  };
+
+  struct Entries {
+    std::mutex mutex;
+    std::map<Key, std::shared_ptr<Slot>> entries;
+  };
+
+  static Entries& Instance() {
+    static Entries instance;
+    return instance;
+  }
+};
+
+}  // namespace GSHTrans
+
+#endif  // GSH_TRANS_REGISTRY_GUARD_H
@@ -0,0 +1,147 @@
+#ifndef GSH_TRANS_TUNING_GUARD_H
+#define GSH_TRANS_TUNING_GUARD_H
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace GSHTrans {
+
+// Settings of a grid's transforms that can be chosen by timing them. A
+// thread count or tile size of zero leaves the grid's default.
+struct GridTuning {
+  int threads = 0;
+  std::ptrdiff_t fftBlockSize = 16;
+  std::ptrdiff_t degreeBlock = 0;
+  std::ptrdiff_t coLatitudeBlock = 0;
+  bool pipelined = false;
+
+  friend bool operator==(const GridTuning&, const GridTuning&) = default;
+};
+
+// Tunings chosen within the process, keyed by the name of the tuning file
+// for a grid's parameters. As with FFTW wisdom, grids built later within
+// the process reuse them, and they can be saved to files for later runs.
+class Tunings {
+ public:
+  // Returns the tuning for the name if one has been chosen.
+  static std::optional<GridTuning> Find(const std::string& name) {
+    auto& [mutex, tunings] = Instance();
+    auto lock = std::lock_guard(mutex);
+    if (auto entry = tunings.find(name); entry != tunings.end()) {
+      return entry->second;
+    }
+    return std::nullopt;
+  }
+
+  static void Insert(const std::string& name, const GridTuning& tuning) {
+    auto& [mutex, tunings] = Instance();
+    auto lock = std::lock_guard(mutex);
+    tunings[name] = tuning;
+  }
+
+  // Forgets all the tunings chosen within the process.
+  static void Clear() {
+    auto& [mutex, tunings] = Instance();
+    auto lock = std::lock_guard(mutex);
+    tunings.clear();
+  }
+
+  // Reads a tuning from a file, returning nothing if it cannot be read or
+  // was made on another machine.
+  static std::optional<GridTuning> Read(const std::filesystem::path& path) {
+    auto file = std::ifstream(path);
+    auto tuning = GridTuning{};
+    auto version = 0;
+    auto machine = std::string{};
+    file >> version >> tuning.threads >> tuning.fftBlockSize >>
+        tuning.degreeBlock >> tuning.coLatitudeBlock >> tuning.pipelined;
+    file >> std::ws;
+    std::getline(file, machine);
+    if (!file || version != Version || machine != Machine() ||
+        tuning.threads < 0 || tuning.fftBlockSize < 1 ||
+        tuning.degreeBlock < 0 || tuning.coLatitudeBlock < 0) {
+      return std::nullopt;
+    }
+    return tuning;
+  }
+
+  // Writes a tuning to a file. As for caches, a temporary file is written
+  // and then renamed. Returns false if the file could not be written.
+  static bool Write(const std::filesystem::path& path,
+                    const GridTuning& tuning) {
+    auto temporary = path;
+    temporary += ".tmp" + std::to_string(::getpid());
+    {
+      auto file = std::ofstream(temporary);
+      if (!file) return false;
+      file << Version << " " << tuning.threads << " " << tuning.fftBlockSize
+           << " " << tuning.degreeBlock << " " << tuning.coLatitudeBlock
+           << " " << tuning.pipelined << "\n"
+           << Machine() << "\n";
+      if (!file) {
+        file.close();
+        auto error = std::error_code{};
+        std::filesystem::remove(temporary, error);
+        return false;
+      }
+    }
+    auto error = std::error_code{};
+    std::filesystem::rename(temporary, path, error);
+    if (error) std::filesystem::remove(temporary, error);
+    return !error;
+  }
+
+  // Returns a line identifying the processor model, the number of hardware
+  // threads and the OpenMP default number of threads. It is saved with
+  // each tuning, and tunings saved with another are ignored.
+  static std::string Machine() {
+    auto model = std::string{"unknown"};
+    auto cpuInfo = std::ifstream("/proc/cpuinfo");
+    for (auto line = std::string{}; std::getline(cpuInfo, line);) {
+      if (line.starts_with("model name")) {
+        auto start = line.find_first_not_of(" \t:", 10);
+        if (start != std::string::npos) model = line.substr(start);
+        break;
+      }
+    }
+#ifdef _OPENMP
+    const auto threads = omp_get_max_threads();
+#else
+    const auto threads = 1;
+#endif
+    return model + ", " +
+           std::to_string(std::thread::hardware_concurrency()) +
+           " hardware threads, " + std::to_string(threads) + " threads";
+  }
+
+ private:
+  // Version of the file format, changed when the settings do.
+  static constexpr int Version = 3;
+
+  struct Entries {
+    std::mutex mutex;
+    std::map<std::string, GridTuning> tunings;
+  };
+
+  static Entries& Instance() {
+    static Entries instance;
+    return instance;
+  }
+};
+
+}  // namespace GSHTrans
+
+#endif  // GSH_TRANS_TUNING_GUARD_H
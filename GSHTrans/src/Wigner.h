@@ -3,12 +3,20 @@
 
 #include <omp.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <concepts>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <numbers>
 #include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Concepts.h"
@@ -19,11 +27,23 @@ namespace GSHTrans {
 template <RealFloatingPoint Real, Normalisation Norm = Ortho,
           OrderIndexRange MRange = All, IndexRange NRange = Single,
           AngleIndexRange AngleRange = Single,
-          MatrixStorage Storage = ColumnMajor>
+          MatrixStorage Storage = ColumnMajor, IndexRange NStorage = NRange,
+          WignerDerivatives Derivatives = ValuesOnly>
+requires std::same_as<NStorage, NRange> or
+         (std::same_as<NRange, All> and std::same_as<NStorage, NonNegative> and
+          std::same_as<MRange, All>)
 class Wigner {
   using Int = std::ptrdiff_t;
   using Vector = std::vector<Real>;
 
+  // Precision in which the values are computed. Single precision values
+  // are computed in double precision and then rounded for storage.
+  using Working = std::conditional_t<std::same_as<Real, float>, double, Real>;
+  using WorkingVector = std::vector<Working>;
+
+  static constexpr bool HasDerivatives =
+      std::same_as<Derivatives, WithDerivatives>;
+
   template <std::ranges::view V>
   class SubView : public std::ranges::view_interface<SubView<V>>,
                   public GSHSubIndices<MRange> {
@@ -42,7 +62,7 @@ class Wigner {
       return this->operator[](i);
     }
 
-    auto &operator()(Int m) {
+    decltype(auto) operator()(Int m) {
       auto i = this->Index(m);
       return this->operator[](i);
     }
@@ -58,8 +78,11 @@ class Wigner {
     using std::ranges::view_interface<View<V>>::size;
 
    public:
-    View(Int lMax, Int mMax, Int n, V view)
-        : Indices(lMax, mMax, n), _view{view} {}
+    View(Int lMax, Int mMax, Int n, V view, std::span<const Int> offsets)
+        : Indices(lMax, mMax, n),
+          _view{view},
+          _offsets{offsets},
+          _base{offsets[std::abs(n)]} {}
 
     auto begin() { return _view.begin(); }
     auto end() { return _view.end(); }
@@ -76,28 +99,59 @@ class Wigner {
 
    private:
     V _view;
+    std::span<const Int> _offsets;  // Degree offsets from the layout.
+    Int _base;                      // Offset of the first degree, |n|.
 
     auto MakeSubRange(Int l) {
-      auto [offset, indices] = this->Index(l);
-      auto size = indices.size();
-      auto start = std::next(begin(), offset);
-      auto end = std::next(start, size);
+      assert(l >= this->MinDegree() && l <= this->MaxDegree());
+      auto start = std::next(begin(), _offsets[l] - _base);
+      auto end = std::next(begin(), _offsets[l + 1] - _base);
       return std::ranges::subrange(start, end);
     }
   };
 
+  // View to the values for upper index n formed from those stored for
+  // |n|. For negative n the values within each degree are reversed and
+  // multiplied by a sign using d^{l}_{m,-n} = (-1)^{m+n} d^{l}_{-m,n}.
+  template <std::ranges::view V>
+  class ReflectedView : public GSHIndices<MRange> {
+    using Indices = GSHIndices<MRange>;
+
+   public:
+    ReflectedView(Int n, View<V> view)
+        : Indices(view.MaxDegree(), view.MaxOrder(), n), _view{view} {}
+
+    auto operator()(Int l) {
+      auto dl = _view(l);
+      auto start = dl.begin();
+      auto size = dl.MaxOrder() - dl.MinOrder() + 1;
+      auto reflect = this->UpperIndex() < 0;
+      auto sign = MinusOneToPower(dl.MinOrder() + this->UpperIndex());
+      auto view =
+          std::ranges::views::iota(Int{0}, size) |
+          std::ranges::views::transform([=](auto i) -> Real {
+            return reflect ? (i % 2 ? -sign : sign) * start[size - 1 - i]
+                           : start[i];
+          });
+      return SubView(l, this->MaxOrder(), view);
+    }
+
+   private:
+    View<V> _view;
+  };
+
   class Arguments {
    public:
     Arguments() = default;
 
-    Arguments(Real theta) {
-      constexpr auto half = static_cast<Real>(1) / static_cast<Real>(2);
+    Arguments(Working theta) {
+      constexpr auto half = static_cast<Working>(1) / static_cast<Working>(2);
       _logSinHalf = std::sin(half * theta);
       _logCosHalf = std::cos(half * theta);
-      _atLeft = _logSinHalf < std::numeric_limits<Real>::min();
-      _atRight = _logCosHalf < std::numeric_limits<Real>::min();
-      _logSinHalf = _atLeft ? static_cast<Real>(0) : std::log(_logSinHalf);
-      _logCosHalf = _atRight ? static_cast<Real>(0) : std::log(_logCosHalf);
+      _atLeft = _logSinHalf < std::numeric_limits<Working>::min();
+      _atRight = _logCosHalf < std::numeric_limits<Working>::min();
+      _logSinHalf = _atLeft ? static_cast<Working>(0) : std::log(_logSinHalf);
+      _logCosHalf = _atRight ? static_cast<Working>(0) : std::log(_logCosHalf);
     }
 
     auto AtLeft() const { return _atLeft; }
@@ -107,8 +161,8 @@ class Wigner {
     auto LogCosHalf() const { return _logCosHalf; }
 
    private:
-    Real _logSinHalf;
-    Real _logCosHalf;
+    Working _logSinHalf;
+    Working _logCosHalf;
     bool _atLeft;
     bool _atRight;
   };
@@ -118,17 +172,128 @@ class Wigner {
 
   template <RealFloatingPointRange RealRange>
   Wigner(Int lMax, Int mMax, Int nMax, RealRange &&thetaRange)
-      : _lMax{lMax}, _mMax{mMax}, _nMax{nMax}, _nTheta(thetaRange.size()) {
+  requires(!std::same_as<NRange, Sparse>)
+      : _lMax{lMax},
+        _mMax{mMax},
+        _nMax{nMax},
+        _nTheta(thetaRange.size()),
+        _lCapacity{lMax},
+        _layout{MakeLayout()} {
+    AllocateStorage();
+    ComputeValues(thetaRange, 0);
+  }
+
+  // Construct with storage reserved for degrees up to lCapacity. The
+  // colatitudes and the final state of the recursion are kept so that
+  // ExtendTo can continue the recursion later. The maximum order is
+  // fixed, and so should be at least the highest degree to be reached if
+  // all orders are wanted.
+  template <RealFloatingPointRange RealRange>
+  Wigner(Int lMax, Int mMax, Int nMax, RealRange &&thetaRange, Int lCapacity)
+  requires(!std::same_as<NRange, Sparse>)
+      : _lMax{lMax},
+        _mMax{mMax},
+        _nMax{nMax},
+        _nTheta(thetaRange.size()),
+        _lCapacity{std::max(lMax, lCapacity)},
+        _layout{MakeLayout()},
+        _extendable{true} {
+    std::ranges::transform(
+        thetaRange, std::back_inserter(_theta),
+        [](auto theta) { return static_cast<Working>(theta); });
     AllocateStorage();
-    ComputeValues(thetaRange);
+    ComputeValues(_theta, 0);
   }
 
   Wigner(Int lMax, Int mMax, Int nMax, Real theta)
-  requires std::same_as<AngleRange, Single>
+  requires(!std::same_as<NRange, Sparse>) and std::same_as<AngleRange, Single>
       : Wigner(lMax, mMax, nMax, std::vector(1, theta)) {}
 
+  // Construct for a given set of upper indices, with values computed and
+  // stored only for those in the set.
+  template <RealFloatingPointRange RealRange>
+  Wigner(Int lMax, Int mMax, std::vector<Int> upperIndices,
+         RealRange &&thetaRange)
+  requires std::same_as<NRange, Sparse>
+      : _lMax{lMax},
+        _mMax{mMax},
+        _upperIndices{SortedUpperIndices(std::move(upperIndices))},
+        _nMax{_upperIndices.back()},
+        _nTheta(thetaRange.size()),
+        _lCapacity{lMax},
+        _layout{MakeLayout()} {
+    AllocateStorage();
+    ComputeValues(thetaRange, 0);
+  }
+
+  Wigner(Int lMax, Int mMax, std::vector<Int> upperIndices, Real theta)
+  requires std::same_as<NRange, Sparse> and std::same_as<AngleRange, Single>
+      : Wigner(lMax, mMax, std::move(upperIndices), std::vector(1, theta)) {}
+
+  // Construct from values already held in memory, such as a mapped cache
+  // file, that is kept alive by the given owner. The values are shared
+  // between copies of the object, and as they may be mapped read only,
+  // they can only be accessed through a const object.
+  Wigner(Int lMax, Int mMax, Int nMax, Int nTheta,
+         std::span<const Real> values, std::shared_ptr<void> owner)
+  requires(!std::same_as<NRange, Sparse>) and (!HasDerivatives)
+      : _lMax{lMax},
+        _mMax{mMax},
+        _nMax{nMax},
+        _nTheta{nTheta},
+        _lCapacity{lMax},
+        _layout{MakeLayout()},
+        _values{values},
+        _owner{std::move(owner)} {
+    assert(values.size() == StorageSize());
+  }
+
+  Wigner(Int lMax, Int mMax, std::vector<Int> upperIndices, Int nTheta,
+         std::span<const Real> values, std::shared_ptr<void> owner)
+  requires std::same_as<NRange, Sparse> and (!HasDerivatives)
+      : _lMax{lMax},
+        _mMax{mMax},
+        _upperIndices{SortedUpperIndices(std::move(upperIndices))},
+        _nMax{_upperIndices.back()},
+        _nTheta{nTheta},
+        _lCapacity{lMax},
+        _layout{MakeLayout()},
+        _values{values},
+        _owner{std::move(owner)} {
+    assert(values.size() == StorageSize());
+  }
+
+  // Extends the table to a higher maximum degree by continuing the
+  // recursion, leaving the existing values in place. Beyond the reserved
+  // capacity, the values are first moved into larger storage.
+  void ExtendTo(Int lMax) {
+    assert(_extendable);
+    assert(lMax >= _lMax);
+    if (lMax == _lMax) return;
+    if (lMax > _lCapacity) Reserve(lMax);
+    auto lStart = _lMax + 1;
+    _lMax = lMax;
+    ComputeValues(_theta, lStart);
+  }
+
+  // Computes the values again at a new colatitude, reusing the storage,
+  // the terms pre-computed for the recursion and its work arrays, so that
+  // nothing is allocated after the first call. This suits values at a
+  // single colatitude that are found for each colatitude in turn.
+  void Recompute(Real theta)
+  requires std::same_as<AngleRange, Single>
+  {
+    assert(!_owner && !_extendable);
+    if (!std::get<0>(_preCompute)) _preCompute = PreCompute();
+    auto thetaRange = std::array{theta};
+    for (auto n : StoredUpperIndices()) {
+      ComputeBatch<1>(n, 0, thetaRange, _preCompute, 0, _state, _work);
+    }
+  }
+
   // Return basic information.
   auto MaxDegree() const { return _lMax; }
+  auto Capacity() const { return _lCapacity; }
   auto MaxOrder() const { return _mMax; }
   auto NumberOfAngles() const { return _nTheta; }
 
@@ -138,15 +303,20 @@ class Wigner {
     return GSHIndices<MRange>(_lMax, _mMax, _nMax).Degrees();
   }
 
-  auto size() const { return _data.size(); }
-  auto begin() { return _data.begin(); }
-  auto end() { return _data.end(); }
+  // The stored values, including any reserved for higher degrees.
+  auto size() const { return Values().size(); }
+  auto begin() { return Values().begin(); }
+  auto end() { return Values().end(); }
+  auto begin() const { return Values().begin(); }
+  auto end() const { return Values().end(); }
 
   auto MinUpperIndex() const {
     if constexpr (std::same_as<NRange, All>) {
       return -_nMax;
     } else if constexpr (std::same_as<NRange, NonNegative>) {
       return Int{0};
+    } else if constexpr (std::same_as<NRange, Sparse>) {
+      return _upperIndices.front();
     } else {
       return _nMax;
     }
@@ -155,7 +325,20 @@ class Wigner {
   auto MaxUpperIndex() const { return _nMax; }
 
   auto UpperIndices() const {
-    return std::ranges::views::iota(MinUpperIndex(), MaxUpperIndex() + 1);
+    if constexpr (std::same_as<NRange, Sparse>) {
+      return std::ranges::views::all(_upperIndices);
+    } else {
+      return std::ranges::views::iota(MinUpperIndex(), MaxUpperIndex() + 1);
+    }
+  }
+
+  // Return the upper indices for which values are stored.
+  auto StoredUpperIndices() const {
+    if constexpr (std::same_as<NStorage, NRange>) {
+      return UpperIndices();
+    } else {
+      return std::ranges::views::iota(Int{0}, MaxUpperIndex() + 1);
+    }
   }
 
   // Return view to angle indices.
@@ -166,51 +349,18 @@ class Wigner {
   // Return pairs of (n,iTheta) in the storage order.
   auto Indices() const {
     if constexpr (std::same_as<Storage, ColumnMajor>) {
-      return std::ranges::views::cartesian_product(UpperIndices(),
+      return std::ranges::views::cartesian_product(StoredUpperIndices(),
                                                    AngleIndices());
     } else {
       return std::ranges::views::cartesian_product(AngleIndices(),
-                                                   UpperIndices());
+                                                   StoredUpperIndices());
     }
   }
 
-  auto operator()(Int n, Int iTheta)
-  requires std::same_as<Storage, ColumnMajor>
-  {
-    auto upperIndices = UpperIndices() | std::ranges::views::filter(
-                                             [n](auto np) { return np < n; });
-    auto size = GSHIndices<MRange>(_lMax, _mMax, n).size();
-    auto offset =
-        size * iTheta +
-        std::ranges::fold_left(upperIndices, Int{0}, [this](auto acc, auto np) {
-          return acc + GSHIndices<MRange>(_lMax, _mMax, np).size();
-        }) * NumberOfAngles();
-    auto start = std::next(begin(), offset);
-    auto finish = std::next(start, size);
-    auto view = std::ranges::subrange(start, finish);
-    return View(_lMax, _mMax, n, view);
-  }
+  auto operator()(Int n, Int iTheta) { return ValuesFor(Values(), n, iTheta); }
 
-  auto operator()(Int n, Int iTheta)
-  requires std::same_as<Storage, RowMajor>
-  {
-    auto size = GSHIndices<MRange>(_lMax, _mMax, n).size();
-    auto offset = std::ranges::fold_left(
-                      UpperIndices(), Int{0},
-                      [this](auto acc, auto n) {
-                        return acc + GSHIndices<MRange>(_lMax, _mMax, n).size();
-                      }) *
-                      iTheta +
-                  std::ranges::fold_left(
-                      UpperIndices() | std::ranges::views::filter(
-                                           [n](auto np) { return np < n; }),
-                      Int{0}, [this](auto acc, auto n) {
-                        return acc + GSHIndices<MRange>(_lMax, _mMax, n).size();
-                      });
-    auto start = std::next(begin(), offset);
-    auto finish = std::next(start, size);
-    auto view = std::ranges::subrange(start, finish);
-    return View(_lMax, _mMax, n, view);
+  auto operator()(Int n, Int iTheta) const {
+    return ValuesFor(Values(), n, iTheta);
   }
 
   auto operator()(Int n)
@@ -231,267 +381,615 @@ class Wigner {
     return operator()(_nMax, 0)(l);
   }
 
+  // Views to the derivatives of the values with respect to colatitude,
+  // which are laid out in the same way as the values.
+  auto Derivative(Int n, Int iTheta)
+  requires HasDerivatives
+  {
+    return ValuesFor(std::span<Real>(_derivativeData), n, iTheta);
+  }
+
+  auto Derivative(Int n)
+  requires HasDerivatives and std::same_as<AngleRange, Single>
+  {
+    return Derivative(n, 0);
+  }
+
+  auto Derivative(Int iTheta)
+  requires HasDerivatives and std::same_as<NRange, Single>
+  {
+    return Derivative(_nMax, iTheta);
+  }
+
+  auto Derivative(Int l)
+  requires HasDerivatives and std::same_as<NRange, Single> and
+           std::same_as<AngleRange, Single>
+  {
+    return Derivative(_nMax, 0)(l);
+  }
+
  private:
   Int _lMax;    // Maximum degree.
   Int _mMax;    // Maximum order.
+  std::vector<Int> _upperIndices;  // Sorted upper indices if sparse.
   Int _nMax;    // Maximum upper index.
-  Int _nTheta;  // Number of colatitudes.
+  Int _nTheta;     // Number of colatitudes.
+  Int _lCapacity;  // Maximum degree for which storage is reserved.
+
+  // Offsets of the stored values for a single colatitude.
+  GSHLayout<MRange> _layout;
 
-  // Vector storing the values.
+  // Vector storing the values, unless they are held externally.
   Vector _data;
+  std::span<const Real> _values;
+  std::shared_ptr<void> _owner;
+
+  // Derivatives with respect to colatitude, if computed.
+  Vector _derivativeData;
+
+  // State of the recursion at the maximum degree, kept for extendable
+  // tables. For each stored (n,iTheta) pair the values at degrees lMax - 1
+  // and lMax are held for orders minOrder to maxOrder, along with the
+  // values for m == -lMax and m == lMax.
+  using Extended = std::pair<Working, Int>;
+  struct RecursionState {
+    Int minOrder = 0;
+    Int maxOrder = -1;
+    WorkingVector x;
+    std::vector<Int> e;
+    std::vector<Extended> boundary;
+
+    auto Stride() const { return 2 * (maxOrder - minOrder + 1); }
+  };
+
+  bool _extendable = false;
+  WorkingVector _theta;
+  RecursionState _state;
+
+  // Work arrays holding the values at the previous two degrees and the
+  // current one within a recursion.
+  struct WorkingValues {
+    WorkingVector x;
+    std::vector<Int> e;
+  };
+  using RecursionWork = std::array<WorkingValues, 3>;
+
+  // Terms and work arrays kept by Recompute for use at later colatitudes.
+  using PreComputed =
+      std::tuple<std::shared_ptr<WorkingVector>, std::shared_ptr<WorkingVector>,
+                 std::shared_ptr<WorkingVector>>;
+  PreComputed _preCompute;
+  RecursionWork _work;
+
+  std::span<Real> Values() {
+    assert(!_owner);
+    return _data;
+  }
+
+  std::span<const Real> Values() const {
+    return _owner ? _values : std::span<const Real>(_data);
+  }
+
+  GSHLayout<MRange> MakeLayout() const {
+    return GSHLayout<MRange>(_lCapacity, _mMax, StoredUpperIndices());
+  }
+
+  // Position of n within the stored upper indices.
+  auto UpperIndexPosition(Int n) const {
+    if constexpr (std::same_as<NRange, Sparse>) {
+      return std::ranges::lower_bound(_upperIndices, n) -
+             _upperIndices.begin();
+    } else {
+      return n - StoredUpperIndices().front();
+    }
+  }
+
+  // Number of values up to the maximum degree for upper index n. With
+  // reserved storage this is less than the size in the layout.
+  auto FilledSize(Int n) const {
+    auto offsets = _layout.DegreeOffsets();
+    return offsets[_lMax + 1] - offsets[std::abs(n)];
+  }
+
+  // Moves the values into storage reserved up to degree lCapacity.
+  void Reserve(Int lCapacity) {
+    auto oldLayout = std::exchange(_layout, GSHLayout<MRange>{});
+    auto oldData = std::exchange(_data, Vector{});
+    auto oldDerivativeData = std::exchange(_derivativeData, Vector{});
+    _lCapacity = lCapacity;
+    _layout = MakeLayout();
+    AllocateStorage();
+    auto move = [&](const Vector &from, Vector &to) {
+      for (auto n : StoredUpperIndices()) {
+        for (auto iTheta : AngleIndices()) {
+          auto offset = [&](auto &layout) {
+            if constexpr (std::same_as<Storage, ColumnMajor>) {
+              return layout.Offset(n) * NumberOfAngles() +
+                     layout.Size(n) * iTheta;
+            } else {
+              return layout.size() * iTheta + layout.Offset(n);
+            }
+          };
+          std::copy_n(std::next(from.begin(), offset(oldLayout)),
+                      FilledSize(n), std::next(to.begin(), offset(_layout)));
+        }
+      }
+    };
+    move(oldData, _data);
+    if constexpr (HasDerivatives) move(oldDerivativeData, _derivativeData);
+  }
+
+  // Return a view to the values within data for given (n,iTheta).
+  template <typename T>
+  auto ValuesFor(std::span<T> data, Int n, Int iTheta) const {
+    if constexpr (std::same_as<NStorage, NRange>) {
+      return StoredValues(data, n, iTheta);
+    } else {
+      return ReflectedView(n, StoredValues(data, std::abs(n), iTheta));
+    }
+  }
+
+  // Return a view to the stored values within data for given (n,iTheta).
+  template <typename T>
+  auto StoredValues(std::span<T> data, Int n, Int iTheta) const
+  requires std::same_as<Storage, ColumnMajor>
+  {
+    auto offset =
+        _layout.Offset(n) * NumberOfAngles() + _layout.Size(n) * iTheta;
+    auto start = std::next(data.begin(), offset);
+    auto finish = std::next(start, FilledSize(n));
+    auto view = std::ranges::subrange(start, finish);
+    return View(_lMax, _mMax, n, view, _layout.DegreeOffsets());
+  }
+
+  template <typename T>
+  auto StoredValues(std::span<T> data, Int n, Int iTheta) const
+  requires std::same_as<Storage, RowMajor>
+  {
+    auto offset = _layout.size() * iTheta + _layout.Offset(n);
+    auto start = std::next(data.begin(), offset);
+    auto finish = std::next(start, FilledSize(n));
+    auto view = std::ranges::subrange(start, finish);
+    return View(_lMax, _mMax, n, view, _layout.DegreeOffsets());
+  }
 
   // Compute the necessary storage capacity.
+  std::size_t StorageSize() const { return _layout.size() * NumberOfAngles(); }
+
   void AllocateStorage() {
-    auto upperIndices = UpperIndices();
-    auto size = std::ranges::fold_left(
-                    upperIndices, Int{0},
-                    [this](auto acc, auto n) {
-                      return acc + GSHIndices<MRange>(_lMax, _mMax, n).size();
-                    }) *
-                NumberOfAngles();
-    _data.resize(size);
+    _data.resize(StorageSize());
+    if constexpr (HasDerivatives) _derivativeData.resize(StorageSize());
   }
 
+  // Compute the values. The work is split into tasks, each for a single
+  // upper index and either a batch of colatitudes whose recursions are
+  // advanced together or one of the remaining colatitudes. The cost of a
+  // task falls as |n| increases, and so tasks are ordered by |n| and
+  // scheduled dynamically to balance the load over threads. Degrees below
+  // lStart are taken to have been computed already, with the recursion
+  // continued from the kept state.
   template <RealFloatingPointRange RealRange>
-  void ComputeValues(RealRange &&thetaRange) {
-    auto preCompute = PreCompute();
-#pragma omp parallel for
-    for (auto [n, iTheta] : Indices()) {
-      auto d = operator()(n, iTheta);
-      Compute(n, thetaRange[iTheta], d, preCompute);
+  void ComputeValues(RealRange &&thetaRange, Int lStart) {
+    const auto preCompute = PreCompute();
+    auto state = RecursionState{};
+    if (_extendable) {
+      constexpr auto extra = Int{HasDerivatives ? 1 : 0};
+      const auto indices = GSHSubIndices<MRange>(_lMax, _mMax);
+      state.minOrder = std::max(-_lMax, indices.MinOrder() - extra);
+      state.maxOrder = std::min(_lMax, indices.MaxOrder() + extra);
+      const auto size = static_cast<Int>(StoredUpperIndices().size()) *
+                        NumberOfAngles();
+      state.x.resize(size * state.Stride());
+      state.e.resize(size * state.Stride());
+      state.boundary.resize(2 * size);
+    }
+    auto upperIndices = std::vector<Int>{};
+    std::ranges::copy(StoredUpperIndices(), std::back_inserter(upperIndices));
+    std::ranges::stable_sort(upperIndices, std::ranges::less{},
+                             [](auto n) { return std::abs(n); });
+    const auto nUpper = static_cast<Int>(upperIndices.size());
+    const auto nBatch = NumberOfAngles() / BatchSize;
+    const auto nTask = nBatch + NumberOfAngles() % BatchSize;
+#pragma omp parallel for schedule(dynamic)
+    for (auto i = Int{0}; i < nUpper * nTask; i++) {
+      auto n = upperIndices[i / nTask];
+      auto task = i % nTask;
+      auto work = RecursionWork{};
+      if (task < nBatch) {
+        ComputeBatch<BatchSize>(n, task * BatchSize, thetaRange, preCompute,
+                                lStart, state, work);
+      } else {
+        ComputeBatch<1>(n, nBatch * BatchSize + task - nBatch, thetaRange,
+                        preCompute, lStart, state, work);
+      }
     }
+    _state = std::move(state);
   }
 
   // Pre-compute some numerical terms used repeatedly within
-  // calculation of the Wigner values for each (theta,n) pair.
+  // calculation of the Wigner values for each (theta,n) pair. These
+  // include the logarithms of factorials used for the initial values.
   auto PreCompute() const {
-    auto size = MaxDegree() + std::max(MaxOrder(), MaxUpperIndex()) + 1;
-    Vector sqrtInt, sqrtIntInv;
+    auto size = MaxDegree() +
+                std::max({MaxOrder(), MaxUpperIndex(), -MinUpperIndex()}) + 2;
+    WorkingVector sqrtInt, sqrtIntInv;
     sqrtInt.reserve(size);
     sqrtIntInv.reserve(size);
     std::generate_n(std::back_inserter(sqrtInt), size, [m = Int{0}]() mutable {
-      return std::sqrt(static_cast<Real>(m++));
+      return std::sqrt(static_cast<Working>(m++));
     });
     std::transform(sqrtInt.begin(), sqrtInt.end(),
                    std::back_inserter(sqrtIntInv),
                    [](auto x) { return x > 0 ? 1 / x : 0; });
-    return std::tuple(std::make_shared<Vector>(sqrtInt),
-                      std::make_shared<Vector>(sqrtIntInv));
+    WorkingVector logFactorial;
+    logFactorial.reserve(2 * MaxDegree() + 1);
+    std::generate_n(std::back_inserter(logFactorial), 2 * MaxDegree() + 1,
+                    [m = Int{0}]() mutable {
+                      return std::lgamma(static_cast<Working>(m++ + 1));
+                    });
+    return std::tuple(std::make_shared<WorkingVector>(sqrtInt),
+                      std::make_shared<WorkingVector>(sqrtIntInv),
+                      std::make_shared<WorkingVector>(logFactorial));
+  }
+
+  // Number of colatitudes within a batch. This is chosen so that a
+  // batch of values fills a 64 byte cache line.
+  static constexpr Int BatchSize =
+      std::max(Int{4}, static_cast<Int>(64 / sizeof(Working)));
+
+  // Values within the recursion are stored in an extended-exponent form,
+  // x * Radix^e, so that those too small to be represented directly are
+  // not lost. For double precision the radix is 2^960. Values with e == 0
+  // are used directly, while others are kept normalised with |x| between
+  // the square roots of Radix^-1 and Radix.
+  static constexpr Int RadixExponent =
+      std::numeric_limits<Working>::max_exponent * 15 / 16;
+
+  static constexpr Working PowerOfTwo(Int e) {
+    auto x = Working{1};
+    for (auto i = Int{0}; i < (e < 0 ? -e : e); i++) x *= 2;
+    return e < 0 ? 1 / x : x;
   }
 
-  void Compute(Int n, Real theta, auto d, const auto preCompute) {
+  static constexpr Working Radix = PowerOfTwo(RadixExponent);
+  static constexpr Working RadixInv = PowerOfTwo(-RadixExponent);
+  static constexpr Working RadixSqrt = PowerOfTwo(RadixExponent / 2);
+  static constexpr Working RadixSqrtInv = PowerOfTwo(-RadixExponent / 2);
+
+  static void Normalise(Working &x, Int &e) {
+    if (x == 0) return;
+    while (std::abs(x) >= RadixSqrt) {
+      x *= RadixInv;
+      e++;
+    }
+    while (std::abs(x) < RadixSqrtInv) {
+      x *= Radix;
+      e--;
+    }
+  }
+
+  // Returns a * x - b * y for values in extended-exponent form.
+  static Extended Combine(Working a, Working x, Int ex, Working b, Working y,
+                          Int ey) {
+    if (x == 0) ex = ey;
+    if (y == 0) ey = ex;
+    auto e = std::max(ex, ey);
+    auto rescale = [e](auto x, auto ex) {
+      return ex == e ? x : ex == e - 1 ? x * RadixInv : Working{0};
+    };
+    auto z = a * rescale(x, ex) - b * rescale(y, ey);
+    Normalise(z, e);
+    return {z, e};
+  }
+
+  // Converts from extended-exponent form, underflowing to zero if needed.
+  static Working ToReal(Working x, Int e) {
+    return e == 0 ? x : std::ldexp(x, static_cast<int>(e * RadixExponent));
+  }
+
+  // Converts a value given by its sign and natural logarithm of its
+  // magnitude into extended-exponent form.
+  static Extended FromLog(Working sign, Working logValue) {
+    const auto log2Value = logValue / std::numbers::ln2_v<Working>;
+    const auto i = std::floor(log2Value);
+    const auto power = static_cast<Int>(i);
+    auto e = power >= 0 ? power / RadixExponent
+                        : -((RadixExponent - 1 - power) / RadixExponent);
+    auto x = sign * std::ldexp(std::exp2(log2Value - i),
+                               static_cast<int>(power - e * RadixExponent));
+    Normalise(x, e);
+    return {x, e};
+  }
+
+  // Computes the values for upper index n at the colatitudes with indices
+  // iTheta0 to iTheta0 + Lanes - 1. The recursion runs over increasing
+  // degree with each order stored in a separate column. The values for
+  // the different colatitudes are interleaved within each column so that
+  // the inner loops can be vectorised.
+  template <Int Lanes>
+  void ComputeBatch(Int n, Int iTheta0, const auto &thetaRange,
+                    const auto &preCompute, Int lStart, RecursionState &state,
+                    RecursionWork &work) {
     // Get references to the pre-computed values.
     auto &sqrtInt = *std::get<0>(preCompute);
     auto &sqrtIntInv = *std::get<1>(preCompute);
+    auto &logFactorial = *std::get<2>(preCompute);
 
-    // Pre-compute and store some terms.
+    // Pre-compute and store some terms. Derivatives at order m need the
+    // values at orders m - 1 and m + 1, and so the recursion is then run
+    // for an extra order either side of those stored.
+    constexpr auto extra = Int{HasDerivatives ? 1 : 0};
     const auto nAbs = std::abs(n);
-    const auto lMax = d.MaxDegree();
-
-    auto arg = Arguments(theta);
-    const auto cos = std::cos(theta);
-
-    // Set the values for l == |n|
-    {
-      const auto l = nAbs;
-      auto m = d(l).MinOrder();
-      auto iter = d(l).begin();
-      auto finish = d(l).end();
-      if (n >= 0) {
-        while (iter != finish) {
-          *iter++ = WignerMaxUpperIndex(l, m++, arg);
-        }
-      } else {
-        while (iter != finish) {
-          *iter++ = WignerMinUpperIndex(l, m++, arg);
-        }
-      }
+    const auto nColumns =
+        GSHSubIndices<MRange>(_lMax, _mMax).size() + 2 * extra;
+    const auto mOffset =
+        extra - GSHSubIndices<MRange>(_lMax, _mMax).MinOrder();
+
+    auto storedViews = [&]<std::size_t... K>(std::span<Real> data,
+                                             std::index_sequence<K...>) {
+      using View = decltype(StoredValues(data, n, iTheta0));
+      return std::array<View, sizeof...(K)>{
+          StoredValues(data, n, iTheta0 + K)...};
+    };
+    auto values = storedViews(Values(), std::make_index_sequence<Lanes>{});
+    auto derivatives =
+        storedViews(std::span<Real>(_derivativeData),
+                    std::make_index_sequence<HasDerivatives ? Lanes : 0>{});
+
+    auto args = std::array<Arguments, Lanes>{};
+    auto cosTheta = std::array<Working, Lanes>{};
+    auto sinCosHalf = std::array<Working, Lanes>{};
+    for (auto k = 0; k < Lanes; k++) {
+      constexpr auto half = static_cast<Working>(1) / static_cast<Working>(2);
+      auto theta = static_cast<Working>(thetaRange[iTheta0 + k]);
+      args[k] = Arguments(theta);
+      cosTheta[k] = std::cos(theta);
+      sinCosHalf[k] = std::sin(half * theta) * std::cos(half * theta);
     }
 
-    // Set the values for l == n+1 if needed.
-    if (nAbs < lMax) {
-      const auto l = nAbs + 1;
-      const auto mMin = d(l).MinOrder();
-      const auto mMax = d(l).MaxOrder();
-      auto m = mMin;
-
-      // Set iterators
-      auto iterMinusOne = d(l - 1).begin();
-      auto finishMinusOne = d(l - 1).end();
-      auto iter = d(l).begin();
-
-      // Add in value at m == -l if needed.
-      if constexpr (std::same_as<MRange, All>) {
-        if (l <= mMax) {
-          *iter++ = WignerMinOrder(l, n, arg);
-          m++;
-        }
+    // Work arrays holding the values at the current and previous two
+    // degrees. Orders not yet reached are left equal to zero.
+    for (auto &values : work) {
+      values.x.assign(nColumns * Lanes, Working{0});
+      values.e.assign(nColumns * Lanes, Int{0});
+    }
+    auto &[minusTwo, minusOne, current] = work;
+    auto column = [mOffset](auto m) { return (m + mOffset) * Lanes; };
+
+    // Values for orders m == -l and m == l, which are updated from one
+    // degree to the next.
+    auto minOrder = std::array<Extended, Lanes>{};
+    auto maxOrder = std::array<Extended, Lanes>{};
+
+    // Index of the kept state for each colatitude in the batch.
+    auto slot = [&](auto k) {
+      return UpperIndexPosition(n) * NumberOfAngles() + iTheta0 + k;
+    };
+
+    const auto lFirst = std::max(nAbs, lStart);
+    if (lFirst == nAbs) {
+      for (auto k = 0; k < Lanes; k++) {
+        minOrder[k] = WignerMinOrder(nAbs, n, args[k], logFactorial);
+        maxOrder[k] = WignerMaxOrder(nAbs, n, args[k], logFactorial);
       }
-
-      // Add in interior orders using one-term recursion.
-      {
-        const auto alpha = (2 * l - 1) * l * cos * sqrtIntInv[l + nAbs];
-        const auto beta = (n < 0 ? -1 : 1) * (2 * l - 1) * sqrtIntInv[l + nAbs];
-
-        while (iterMinusOne != finishMinusOne) {
-          const auto f1 =
-              (alpha - beta * m) * sqrtIntInv[l - m] * sqrtIntInv[l + m];
-          *iter++ = f1 * *iterMinusOne++;
-          m++;
+    } else {
+      // Continue the recursion from the kept state.
+      const auto size = _state.Stride() / 2;
+      for (auto k = 0; k < Lanes; k++) {
+        auto i = slot(k);
+        minOrder[k] = _state.boundary[2 * i];
+        maxOrder[k] = _state.boundary[2 * i + 1];
+        for (auto m = _state.minOrder; m <= _state.maxOrder; m++) {
+          auto j = column(m) + k;
+          auto iTwo = i * _state.Stride() + m - _state.minOrder;
+          auto iOne = iTwo + size;
+          minusTwo.x[j] = _state.x[iTwo];
+          minusTwo.e[j] = _state.e[iTwo];
+          minusOne.x[j] = _state.x[iOne];
+          minusOne.e[j] = _state.e[iOne];
         }
       }
-
-      // Add in value at m == l if needed
-      if (l <= mMax) {
-        *iter++ = WignerMaxOrder(l, n, arg);
-      }
     }
 
-    // Do the remaining degrees
-    for (auto l = nAbs + 2; l <= lMax; l++) {
-      const auto mMin = d(l).MinOrder();
-      const auto mMax = d(l).MaxOrder();
-      auto m = mMin;
-
-      // Set iterators.
-      auto iterMinusTwo = d(l - 2).begin();
-      auto finishMinusTwo = d(l - 2).end();
-      auto iterMinusOne = d(l - 1).begin();
-      auto iter = d(l).begin();
-
-      // Add in lower boundary terms if still growing.
-      if constexpr (std::same_as<MRange, All>) {
-        if (l <= mMax) {
-          {
-            // Add in the m == -l term.
-            *iter++ = WignerMinOrder(l, n, arg);
-            m++;
-          }
-          {
-            // Now do the m == -l+1 term using one-point recursion.
-            const auto f1 = (2 * l - 1) * (l * (l - 1) * cos - m * n) *
-                            sqrtIntInv[l - n] * sqrtIntInv[l + n] *
-                            sqrtIntInv[l - m] * sqrtIntInv[l + m] /
-                            static_cast<Real>(l - 1);
-            *iter++ = f1 * (*iterMinusOne++);
-            m++;
+    for (auto l = lFirst; l <= _lMax; l++) {
+      const auto indices = GSHSubIndices<MRange>(l, _mMax);
+      const auto mMin = std::max(-l, indices.MinOrder() - extra);
+      const auto mMax = std::min(l, indices.MaxOrder() + extra);
+
+      if (l == nAbs) {
+        // Set the values for l == |n|.
+        for (auto m = mMin; m <= mMax; m++) {
+          auto j = column(m);
+          for (auto k = 0; k < Lanes; k++) {
+            std::tie(current.x[j + k], current.e[j + k]) =
+                n >= 0 ? WignerMaxUpperIndex(l, m, args[k], logFactorial)
+                       : WignerMinUpperIndex(l, m, args[k], logFactorial);
           }
         }
-
-        // Add in the lower boundary term at the critical degree.
-        if (l == mMax + 1) {
-          const auto f1 = (2 * l - 1) * (l * (l - 1) * cos - m * n) *
-                          sqrtIntInv[l - n] * sqrtIntInv[l + n] *
-                          sqrtIntInv[l - m] * sqrtIntInv[l + m] /
-                          static_cast<Real>(l - 1);
-          *iter++ = f1 * (*iterMinusOne++);
-          m++;
+      } else {
+        // Update the values for orders m == -l and m == l.
+        const auto ratio =
+            std::sqrt(static_cast<Working>(2 * l * (2 * l - 1))) *
+            sqrtIntInv[l - n] * sqrtIntInv[l + n];
+        for (auto k = 0; k < Lanes; k++) {
+          auto &[xMin, eMin] = minOrder[k];
+          auto &[xMax, eMax] = maxOrder[k];
+          xMin *= ratio * sinCosHalf[k];
+          xMax *= -ratio * sinCosHalf[k];
+          Normalise(xMin, eMin);
+          Normalise(xMax, eMax);
         }
-      }
 
-      // Apply two-term recusion for the interior orders.
-      {
+        // Coefficients for the recursion. Orders new at degree l - 1 have
+        // no value at degree l - 2, and their second coefficient vanishes
+        // so that the recursion reduces to a single term.
         const auto alpha =
-            (2 * l - 1) * l * cos * sqrtIntInv[l - n] * sqrtIntInv[l + n];
-        const auto beta = (2 * l - 1) * n * sqrtIntInv[l - n] *
-                          sqrtIntInv[l + n] / static_cast<Real>(l - 1);
-        const auto gamma = l * sqrtInt[l - 1 - n] * sqrtInt[l - 1 + n] *
-                           sqrtIntInv[l - n] * sqrtIntInv[l + n] /
-                           static_cast<Real>(l - 1);
-
-        while (iterMinusTwo != finishMinusTwo) {
+            (2 * l - 1) * l * sqrtIntInv[l - n] * sqrtIntInv[l + n];
+        const auto beta = n == 0 ? Working{0}
+                                 : (2 * l - 1) * n * sqrtIntInv[l - n] *
+                                       sqrtIntInv[l + n] /
+                                       static_cast<Working>(l - 1);
+        const auto gamma = l == 1 ? Working{0}
+                                  : l * sqrtInt[l - 1 - n] *
+                                        sqrtInt[l - 1 + n] *
+                                        sqrtIntInv[l - n] * sqrtIntInv[l + n] /
+                                        static_cast<Working>(l - 1);
+
+        for (auto m = mMin; m <= mMax; m++) {
+          auto j = column(m);
+          if (std::abs(m) == l) {
+            // Add in the boundary terms while still growing.
+            for (auto k = 0; k < Lanes; k++) {
+              std::tie(current.x[j + k], current.e[j + k]) =
+                  m < 0 ? minOrder[k] : maxOrder[k];
+            }
+            continue;
+          }
+
+          // Apply two-term recursion for the interior orders.
           const auto denom = sqrtIntInv[l - m] * sqrtIntInv[l + m];
-          const auto f1 = (alpha - beta * m) * denom;
+          const auto f1 = alpha * denom;
+          const auto g1 = beta * m * denom;
           const auto f2 =
               gamma * sqrtInt[l - 1 - m] * sqrtInt[l - 1 + m] * denom;
-          *iter++ = f1 * *iterMinusOne++ - f2 * *iterMinusTwo++;
-          m++;
+
+          auto scaled = Int{0};
+          for (auto k = 0; k < Lanes; k++) {
+            scaled |= minusOne.e[j + k] | minusTwo.e[j + k];
+          }
+
+          if (scaled != 0) {
+            for (auto k = 0; k < Lanes; k++) {
+              std::tie(current.x[j + k], current.e[j + k]) =
+                  Combine(f1 * cosTheta[k] - g1, minusOne.x[j + k],
+                          minusOne.e[j + k], f2, minusTwo.x[j + k],
+                          minusTwo.e[j + k]);
+            }
+          } else {
+            auto x = &current.x[j];
+            auto x1 = &minusOne.x[j];
+            auto x2 = &minusTwo.x[j];
+#pragma omp simd
+            for (auto k = 0; k < Lanes; k++) {
+              x[k] = (f1 * cosTheta[k] - g1) * x1[k] - f2 * x2[k];
+            }
+            std::fill_n(&current.e[j], Lanes, 0);
+          }
         }
       }
 
-      // Add in the upper boundary terms if still growing.
-      if (l <= mMax) {
-        // Add in m == l - 1 term using one-point recursion.
-        {
-          const auto f1 = (2 * l - 1) * (l * (l - 1) * cos - m * n) *
-                          sqrtIntInv[l - n] * sqrtIntInv[l + n] *
-                          sqrtIntInv[l - m] * sqrtIntInv[l + m] /
-                          static_cast<Real>(l - 1);
-          *iter++ = f1 * (*iterMinusOne++);
-          m++;
+      // Copy the values into storage, normalising if needed.
+      const auto factor = [l]() {
+        if constexpr (std::same_as<Norm, Ortho>) {
+          return std::numbers::inv_sqrtpi_v<Working> / static_cast<Working>(2) *
+                 std::sqrt(static_cast<Working>(2 * l + 1));
+        } else {
+          return Working{1};
+        }
+      }();
+      for (auto k = 0; k < Lanes; k++) {
+        auto d = values[k](l);
+        auto j = column(indices.MinOrder()) + k;
+        for (auto &p : d) {
+          p = static_cast<Real>(ToReal(factor * current.x[j], current.e[j]));
+          j += Lanes;
         }
-        // Now do m == l.
-        *iter++ = WignerMaxOrder(l, n, arg);
       }
 
-      // Add in the upper boundary term at the critical degree.
-      if (l == mMax + 1) {
-        // Update the iterators.
-
-        const auto f1 = (2 * l - 1) * (l * (l - 1) * cos - m * n) *
-                        sqrtIntInv[l - n] * sqrtIntInv[l + n] *
-                        sqrtIntInv[l - m] * sqrtIntInv[l + m] /
-                        static_cast<Real>(l - 1);
-        *iter++ = f1 * (*iterMinusOne++);
+      // Form the derivatives using the relation
+      // 2 d'^{l}_{mn} = sqrt((l-m)(l+m+1)) d^{l}_{m+1,n}
+      //                 - sqrt((l+m)(l-m+1)) d^{l}_{m-1,n}.
+      if constexpr (HasDerivatives) {
+        constexpr auto half = static_cast<Working>(1) / static_cast<Working>(2);
+        for (auto k = 0; k < Lanes; k++) {
+          auto d = derivatives[k](l);
+          auto m = indices.MinOrder();
+          auto j = column(m) + k;
+          for (auto &p : d) {
+            auto below = m > -l ? ToReal(current.x[j - Lanes],
+                                          current.e[j - Lanes])
+                                : Working{0};
+            auto above = m < l ? ToReal(current.x[j + Lanes],
+                                         current.e[j + Lanes])
+                               : Working{0};
+            p = static_cast<Real>(
+                half * factor *
+                (sqrtInt[l - m] * sqrtInt[l + m + 1] * above -
+                 sqrtInt[l + m] * sqrtInt[l - m + 1] * below));
+            m++;
+            j += Lanes;
+          }
+        }
       }
+
+      std::swap(minusTwo, minusOne);
+      std::swap(minusOne, current);
     }
 
-    // Normalise the values if needed.
-    if constexpr (std::same_as<Norm, Ortho>) {
-      const auto factor =
-          std::numbers::inv_sqrtpi_v<Real> / static_cast<Real>(2);
-      for (auto l : d.Degrees()) {
-        auto start = d(l).begin();
-        auto finish = d(l).end();
-
-        std::transform(start, finish, start, [l, factor](auto p) {
-          return factor * std::sqrt(static_cast<Real>(2 * l + 1)) * p;
-        });
+    // Keep the state so that the recursion can be continued.
+    if (_extendable) {
+      const auto size = state.Stride() / 2;
+      for (auto k = 0; k < Lanes; k++) {
+        auto i = slot(k);
+        state.boundary[2 * i] = minOrder[k];
+        state.boundary[2 * i + 1] = maxOrder[k];
+        for (auto m = state.minOrder; m <= state.maxOrder; m++) {
+          auto j = column(m) + k;
+          auto iTwo = i * state.Stride() + m - state.minOrder;
+          auto iOne = iTwo + size;
+          state.x[iTwo] = minusTwo.x[j];
+          state.e[iTwo] = minusTwo.e[j];
+          state.x[iOne] = minusOne.x[j];
+          state.e[iOne] = minusOne.e[j];
+        }
       }
     }
   }
 
-  constexpr auto MinusOneToPower(Int m) { return m % 2 ? -1 : 1; }
+  static constexpr Real MinusOneToPower(Int m) { return m % 2 ? -1 : 1; }
 
-  auto WignerMinOrder(Int l, Int n, Arguments &arg) {
+  // Returns the value for order m == -l in extended-exponent form.
+  Extended WignerMinOrder(Int l, Int n, const Arguments &arg,
+                          const WorkingVector &logFactorial) {
     // Check the inputs.
     assert(l >= 0);
     assert(std::abs(n) <= l);
 
     // Deal with l == 0 case
-    if (l == 0) return static_cast<Real>(1);
+    if (l == 0) return {1, 0};
 
     // Deal with special case at the left boundary.
     if (arg.AtLeft()) {
-      return n == -l ? static_cast<Real>(1) : static_cast<Real>(0);
+      return {n == -l ? Working{1} : Working{0}, 0};
     }
 
     // Deal with special case at the right boundary.
     if (arg.AtRight()) {
-      return n == l ? static_cast<Real>(1) : static_cast<Real>(0);
+      return {n == l ? Working{1} : Working{0}, 0};
     }
 
     // Deal with the general case.
-    constexpr auto half = static_cast<Real>(1) / static_cast<Real>(2);
-    auto Fl = static_cast<Real>(l);
-    auto Fn = static_cast<Real>(n);
-    using std::exp;
-    using std::lgamma;
-    return exp(half * (lgamma(2 * Fl + 1) - lgamma(Fl - Fn + 1) -
-                       lgamma(Fl + Fn + 1)) +
-               (Fl + Fn) * arg.LogSinHalf() + (Fl - Fn) * arg.LogCosHalf());
+    constexpr auto half = static_cast<Working>(1) / static_cast<Working>(2);
+    return FromLog(1, half * (logFactorial[2 * l] - logFactorial[l - n] -
+                              logFactorial[l + n]) +
+                          (l + n) * arg.LogSinHalf() +
+                          (l - n) * arg.LogCosHalf());
   }
 
-  auto WignerMaxOrder(Int l, Int n, Arguments &arg) {
-    return MinusOneToPower(n + l) * WignerMinOrder(l, -n, arg);
+  Extended WignerMaxOrder(Int l, Int n, const Arguments &arg,
+                          const WorkingVector &logFactorial) {
+    auto [x, e] = WignerMinOrder(l, -n, arg, logFactorial);
+    return {MinusOneToPower(n + l) * x, e};
   }
 
-  auto WignerMinUpperIndex(Int l, Int m, Arguments &arg) {
-    return WignerMaxOrder(l, -m, arg);
+  Extended WignerMinUpperIndex(Int l, Int m, const Arguments &arg,
+                               const WorkingVector &logFactorial) {
+    return WignerMaxOrder(l, -m, arg, logFactorial);
   }
 
-  auto WignerMaxUpperIndex(Int l, Int m, Arguments &arg) {
-    return WignerMinOrder(l, -m, arg);
+  Extended WignerMaxUpperIndex(Int l, Int m, const Arguments &arg,
+                               const WorkingVector &logFactorial) {
+    return WignerMinOrder(l, -m, arg, logFactorial);
   }
 };
 
@@ -0,0 +1,81 @@
+#include <GSHTrans/All>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <iomanip>
+#include <iostream>
+
+using namespace GSHTrans;
+
+using Int = std::ptrdiff_t;
+
+// Times the inverse and forward transformations of a complex field on a
+// grid whose Legendre stage is summed over tiles of the given numbers of
+// degrees and colatitudes.
+auto Timings(Int lMax, Int degrees, Int coLatitudes, int repeats) {
+  using Real = double;
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All, Precomputed, Equatorial>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto n = 0;
+  auto grid = Grid(lMax, n);
+  grid.SetNumberOfThreads(1);
+  grid.SetLegendreBlockSizes(degrees, coLatitudes);
+
+  auto flm = FFTWpp::vector<Complex>(grid.ComplexCoefficientSize(lMax, n));
+  grid.RandomComplexCoefficient(lMax, n, flm);
+  auto f = FFTWpp::vector<Complex>(grid.ComponentSize());
+  auto glm = FFTWpp::vector<Complex>(flm.size());
+
+  // Warm up so that the work arrays are in place.
+  grid.InverseTransformation(lMax, n, flm, f);
+  grid.ForwardTransformation(lMax, n, f, glm);
+
+  auto inverse = 0.0;
+  auto forward = 0.0;
+  for (auto i = 0; i < repeats; i++) {
+    auto start = Clock::now();
+    grid.InverseTransformation(lMax, n, flm, f);
+    inverse += Seconds(Clock::now() - start).count();
+    std::ranges::fill(glm, Complex{0});
+    start = Clock::now();
+    grid.ForwardTransformation(lMax, n, f, glm);
+    forward += Seconds(Clock::now() - start).count();
+  }
+
+  // Bytes of Wigner values read by each transform, these being stored for
+  // the northern colatitudes and the equator.
+  auto nStored = (grid.CoLatitudes().size() + 1) / 2;
+  auto bytes = static_cast<double>(nStored) *
+               static_cast<double>(GSHIndices<All>(lMax, lMax, n).size()) *
+               sizeof(Real);
+  return std::tuple(inverse / repeats, forward / repeats, bytes);
+}
+
+int main() {
+  // Untiled transforms read all the coefficients for each colatitude in
+  // the inverse transform, and write them for each colatitude in the
+  // forward one. The default tiles keep a block of coefficients in cache
+  // while it is used for a block of colatitudes. Rates are given as the
+  // Wigner values read per second.
+  auto repeats = 3;
+  std::cout << std::setw(6) << "lMax" << std::setw(14) << "untiled(s)"
+            << std::setw(10) << "GB/s" << std::setw(14) << "tiled(s)"
+            << std::setw(10) << "GB/s" << std::setw(10) << "speedup"
+            << std::endl;
+  for (auto lMax : {64, 128, 256, 512, 768}) {
+    auto [inverse1, forward1, bytes] = Timings(lMax, lMax + 1, 1, repeats);
+    auto [inverse2, forward2, _] = Timings(lMax, 0, 0, repeats);
+    auto untiled = inverse1 + forward1;
+    auto tiled = inverse2 + forward2;
+    std::cout << std::setw(6) << lMax << std::setw(14) << std::setprecision(4)
+              << untiled << std::setw(10) << 2 * bytes / untiled / 1e9
+              << std::setw(14) << tiled << std::setw(10)
+              << 2 * bytes / tiled / 1e9 << std::setw(10) << untiled / tiled
+              << std::endl;
+  }
+
+  FFTWpp::CleanUp();
+}
@@ -0,0 +1,46 @@
+#include <GSHTrans/All>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+using namespace GSHTrans;
+
+// Compares the time taken to construct a grid when the quadrature and
+// Wigner values are computed and written to a cache file, with the time
+// taken when they are read back from that file.
+int main() {
+  using Real = double;
+  using Grid = GaussLegendreGrid<Real, All, All>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto directory = std::filesystem::temp_directory_path() / "GSHTransCache";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  auto nMax = 2;
+  std::cout << std::setw(6) << "lMax" << std::setw(14) << "cold(s)"
+            << std::setw(14) << "warm(s)" << std::setw(12) << "ratio"
+            << std::endl;
+  for (auto lMax : {32, 64, 128, 256}) {
+    // The first grid is destroyed before the second is made, as grids
+    // alive at the same time share their values through the registry.
+    auto start = Clock::now();
+    {
+      auto cold = Grid(lMax, nMax, directory, FFTWpp::Estimate);
+    }
+    auto coldTime = Seconds(Clock::now() - start).count();
+
+    start = Clock::now();
+    auto warm = Grid(lMax, nMax, directory, FFTWpp::Estimate);
+    auto warmTime = Seconds(Clock::now() - start).count();
+
+    std::cout << std::setw(6) << lMax << std::setw(14) << std::setprecision(4)
+              << coldTime << std::setw(14) << warmTime << std::setw(12)
+              << coldTime / warmTime << std::endl;
+  }
+
+  std::filesystem::remove_all(directory);
+  FFTWpp::CleanUp();
+}
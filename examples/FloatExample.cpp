@@ -0,0 +1,62 @@
+#include <GSHTrans/All>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace GSHTrans;
+
+using Int = std::ptrdiff_t;
+
+// Times a round trip of transformations for a grid of the given precision,
+// returning the time and the largest error in the recovered coefficients.
+template <RealFloatingPoint Real>
+auto Timings(Int lMax, Int nMax, Int n, int repeats) {
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto grid = Grid(lMax, nMax);
+
+  auto flm = FFTWpp::vector<Complex>(grid.RealCoefficientSize(lMax, n));
+  grid.RandomRealCoefficient(lMax, n, flm);
+  auto f = FFTWpp::vector<Real>(grid.ComponentSize());
+  auto glm = FFTWpp::vector<Complex>(flm.size());
+
+  auto start = Clock::now();
+  for (auto i = 0; i < repeats; i++) {
+    std::ranges::fill(glm, Complex{0});
+    grid.InverseTransformation(lMax, n, flm, f);
+    grid.ForwardTransformation(lMax, n, f, glm);
+  }
+  auto time = Seconds(Clock::now() - start).count() / repeats;
+
+  auto error = Real{0};
+  for (auto i = std::size_t{0}; i < flm.size(); i++) {
+    error = std::max(error, std::abs(flm[i] - glm[i]));
+  }
+
+  return std::pair(time, static_cast<double>(error));
+}
+
+int main() {
+  auto nMax = 2;
+  auto n = 0;
+  std::cout << std::setw(6) << "lMax" << std::setw(14) << "double(s)"
+            << std::setw(14) << "float(s)" << std::setw(10) << "ratio"
+            << std::setw(14) << "double err" << std::setw(14) << "float err"
+            << std::endl;
+  for (auto lMax : {16, 32, 64, 128, 256}) {
+    auto repeats = std::max(1, 4096 / lMax);
+    auto [full, fullError] = Timings<double>(lMax, nMax, n, repeats);
+    auto [single, singleError] = Timings<float>(lMax, nMax, n, repeats);
+    std::cout << std::setw(6) << lMax << std::setw(14) << std::setprecision(4)
+              << full << std::setw(14) << single << std::setw(10)
+              << full / single << std::setw(14) << fullError << std::setw(14)
+              << singleError << std::endl;
+  }
+
+  FFTWpp::CleanUp();
+}
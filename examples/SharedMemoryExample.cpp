@@ -0,0 +1,71 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <GSHTrans/All>
+#include <chrono>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace GSHTrans;
+
+// Returns the proportional set size of the process in megabytes, which
+// divides shared pages between the processes mapping them.
+double ProportionalSetSize() {
+  auto file = std::ifstream("/proc/self/smaps_rollup");
+  auto line = std::string{};
+  while (std::getline(file, line)) {
+    if (line.starts_with("Pss:")) return std::stod(line.substr(4)) / 1024;
+  }
+  return 0;
+}
+
+// Starts several processes that each construct the same grid using shared
+// memory. The first to start computes the values and the others map them,
+// so that the memory used per process falls as their number increases.
+int main() {
+  using Real = double;
+  using Grid = GaussLegendreGrid<Real, All, All>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto lMax = 128;
+  auto nMax = 2;
+  auto nProcess = 4;
+  auto shared = SharedMemory{"GSHTransExample" + std::to_string(::getpid())};
+
+  std::cout << std::setw(8) << "process" << std::setw(14) << "build(s)"
+            << std::setw(12) << "PSS(MB)" << std::endl;
+  for (auto i = 0; i < nProcess; i++) {
+    if (::fork() == 0) {
+      auto start = Clock::now();
+      auto grid = Grid(lMax, nMax, shared, FFTWpp::Estimate);
+      auto time = Seconds(Clock::now() - start).count();
+
+      // Transform a field for each upper index so that all of the Wigner
+      // values are read.
+      for (auto n : grid.UpperIndices()) {
+        auto flm = FFTWpp::vector<std::complex<Real>>(
+            grid.RealCoefficientSize(lMax, n));
+        grid.RandomRealCoefficient(lMax, n, flm);
+        auto f = FFTWpp::vector<Real>(grid.ComponentSize());
+        grid.InverseTransformation(lMax, n, flm, f);
+      }
+
+      // Wait for all processes to map the values before measuring.
+      ::sleep(1);
+      std::cout << std::setw(8) << i << std::setw(14) << std::setprecision(4)
+                << time << std::setw(12) << ProportionalSetSize()
+                << std::endl;
+      return 0;
+    }
+  }
+  for (auto i = 0; i < nProcess; i++) ::wait(nullptr);
+
+  // Remove the segment, which otherwise persists until the node restarts.
+  auto grid = Grid(lMax, nMax, shared, FFTWpp::Estimate);
+  SharedSegment::Remove(grid.SharedMemoryName(shared));
+  FFTWpp::CleanUp();
+}
@@ -0,0 +1,83 @@
+#include <GSHTrans/All>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace GSHTrans;
+
+using Int = std::ptrdiff_t;
+
+// Times the inverse and forward transformations of a complex field on a
+// grid using the given number of threads.
+template <WignerEvaluation Evaluation>
+auto Timings(Int lMax, Int n, int threads, int repeats) {
+  using Real = double;
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto grid = Grid(lMax, std::abs(n));
+  grid.SetNumberOfThreads(threads);
+
+  auto flm = FFTWpp::vector<Complex>(grid.ComplexCoefficientSize(lMax, n));
+  grid.RandomComplexCoefficient(lMax, n, flm);
+  auto f = FFTWpp::vector<Complex>(grid.ComponentSize());
+  auto glm = FFTWpp::vector<Complex>(flm.size());
+
+  // Warm up so that the work arrays of each thread are in place.
+  grid.InverseTransformation(lMax, n, flm, f);
+  grid.ForwardTransformation(lMax, n, f, glm);
+
+  auto inverse = 0.0;
+  auto forward = 0.0;
+  for (auto i = 0; i < repeats; i++) {
+    auto start = Clock::now();
+    grid.InverseTransformation(lMax, n, flm, f);
+    inverse += Seconds(Clock::now() - start).count();
+    std::ranges::fill(glm, Complex{0});
+    start = Clock::now();
+    grid.ForwardTransformation(lMax, n, f, glm);
+    forward += Seconds(Clock::now() - start).count();
+  }
+
+  return std::pair(inverse / repeats, forward / repeats);
+}
+
+int main() {
+#ifdef _OPENMP
+  auto maxThreads = omp_get_max_threads();
+#else
+  auto maxThreads = 1;
+#endif
+
+  auto lMax = 512;
+  auto n = 1;
+  auto repeats = 4;
+  std::cout << std::setw(8) << "threads" << std::setw(14) << "inverse(s)"
+            << std::setw(14) << "forward(s)" << std::setw(10) << "speedup"
+            << std::setw(14) << "onthefly(s)" << std::setw(10) << "speedup"
+            << std::endl;
+  auto [inverse1, forward1] = Timings<Precomputed>(lMax, n, 1, repeats);
+  auto [inverse2, forward2] = Timings<OnTheFly>(lMax, n, 1, repeats);
+  for (auto threads = 1; threads <= maxThreads; threads *= 2) {
+    auto [inverse, forward] = Timings<Precomputed>(lMax, n, threads, repeats);
+    auto [inverseOTF, forwardOTF] =
+        Timings<OnTheFly>(lMax, n, threads, repeats);
+    std::cout << std::setw(8) << threads << std::setw(14)
+              << std::setprecision(4) << inverse << std::setw(14) << forward
+              << std::setw(10) << (inverse1 + forward1) / (inverse + forward)
+              << std::setw(14) << inverseOTF + forwardOTF << std::setw(10)
+              << (inverse2 + forward2) / (inverseOTF + forwardOTF)
+              << std::endl;
+  }
+
+  FFTWpp::CleanUp();
+}
@@ -0,0 +1,73 @@
+#include <GSHTrans/All>
+#include <chrono>
+#include <complex>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+using namespace GSHTrans;
+
+using Int = std::ptrdiff_t;
+
+// Returns the time for an inverse and forward transformation of a complex
+// field, taking the least of a few repeats.
+template <typename Grid>
+auto Timing(const Grid& grid, Int lMax, Int n, int repeats) {
+  using Complex = std::complex<double>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto flm = FFTWpp::vector<Complex>(grid.ComplexCoefficientSize(lMax, n));
+  grid.RandomComplexCoefficient(lMax, n, flm);
+  auto f = FFTWpp::vector<Complex>(grid.ComponentSize());
+  auto glm = FFTWpp::vector<Complex>(flm.size());
+  grid.InverseTransformation(lMax, n, flm, f);
+  grid.ForwardTransformation(lMax, n, f, glm);
+
+  auto best = 0.0;
+  for (auto i = 0; i < repeats; i++) {
+    auto start = Clock::now();
+    grid.InverseTransformation(lMax, n, flm, f);
+    grid.ForwardTransformation(lMax, n, f, glm);
+    auto seconds = Seconds(Clock::now() - start).count();
+    best = i == 0 ? seconds : std::min(best, seconds);
+  }
+  return best;
+}
+
+int main() {
+  using Grid = GaussLegendreGrid<double, All, All, Precomputed, Equatorial>;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  // Tunings are saved within this directory, so that running the example
+  // again reads them rather than timing the candidates.
+  auto directory = std::filesystem::path("tuning");
+  std::filesystem::create_directories(directory);
+
+  auto n = 0;
+  auto repeats = 3;
+  std::cout << std::setw(6) << "lMax" << std::setw(10) << "tune(s)"
+            << std::setw(9) << "threads" << std::setw(7) << "fft"
+            << std::setw(9) << "degrees" << std::setw(9) << "colats"
+            << std::setw(14) << "default(s)" << std::setw(12) << "tuned(s)"
+            << std::endl;
+  for (auto lMax : {32, 128, 512}) {
+    auto grid = Grid(lMax, n);
+    auto defaults = Timing(grid, lMax, n, repeats);
+
+    auto start = Clock::now();
+    grid.Autotune(directory);
+    auto tune = Seconds(Clock::now() - start).count();
+    auto tuning = grid.Tuning();
+    auto tuned = Timing(grid, lMax, n, repeats);
+
+    std::cout << std::setw(6) << lMax << std::setw(10) << std::setprecision(3)
+              << tune << std::setw(9) << tuning.threads << std::setw(7)
+              << tuning.fftBlockSize << std::setw(9) << tuning.degreeBlock
+              << std::setw(9) << tuning.coLatitudeBlock << std::setw(14)
+              << defaults << std::setw(12) << tuned << std::endl;
+  }
+
+  FFTWpp::CleanUp();
+}
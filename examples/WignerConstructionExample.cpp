@@ -0,0 +1,43 @@
+#include <omp.h>
+
+#include <GSHTrans/All>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <vector>
+
+using namespace GSHTrans;
+
+// Times construction of a Wigner table at the colatitudes of a grid for
+// increasing numbers of threads.
+int main() {
+  using Real = double;
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  auto nMax = 4;
+  auto maxThreads = omp_get_max_threads();
+
+  std::cout << std::setw(6) << "lMax" << std::setw(10) << "threads"
+            << std::setw(14) << "time(s)" << std::setw(12) << "speedup"
+            << std::endl;
+  for (auto lMax : {64, 128, 256}) {
+    auto theta = std::vector<Real>(lMax + 1);
+    for (auto i = 0; i <= lMax; i++) {
+      theta[i] = std::numbers::pi_v<Real> * (i + Real{0.5}) / (lMax + 1);
+    }
+
+    auto serial = 0.0;
+    for (auto threads = 1; threads <= maxThreads; threads *= 2) {
+      omp_set_num_threads(threads);
+      auto start = Clock::now();
+      auto d = Wigner<Real, Ortho, All, All, Multiple>(lMax, lMax, nMax, theta);
+      auto time = Seconds(Clock::now() - start).count();
+      if (threads == 1) serial = time;
+      std::cout << std::setw(6) << lMax << std::setw(10) << threads
+                << std::setw(14) << std::setprecision(4) << time
+                << std::setw(12) << serial / time << std::endl;
+    }
+  }
+}
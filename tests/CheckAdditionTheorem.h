@@ -10,7 +10,8 @@
 #include <numbers>
 #include <random>
 
-template <std::floating_point Real>
+template <std::floating_point Real,
+          GSHTrans::IndexRange NStorage = GSHTrans::All>
 int CheckAdditionTheorem() {
   using namespace GSHTrans;
 
@@ -26,7 +27,8 @@ int CheckAdditionTheorem() {
                                              std::numbers::pi_v<Real>};
   auto theta = dist1(gen);
 
-  auto d = Wigner<Real, FourPi, All, All>(lMax, lMax, lMax, theta);
+  auto d = Wigner<Real, FourPi, All, All, Single, ColumnMajor, NStorage>(
+      lMax, lMax, lMax, theta);
 
   constexpr auto eps = 1000 * std::numeric_limits<Real>::epsilon();
 
@@ -0,0 +1,51 @@
+#ifndef CHECK_ALLOCATIONS_GUARD_H
+#define CHECK_ALLOCATIONS_GUARD_H
+
+#include <FFTWpp/Core>
+#include <GSHTrans/All>
+#include <complex>
+
+// Number of allocations made through the global operator new and, where
+// FFTW is linked, through its allocators. Defined in CountAllocations.cpp.
+long Allocations();
+
+using namespace GSHTrans;
+
+// Checks that once a grid's work arrays and Wigner values are in place,
+// repeated transforms of real and complex fields neither build workspaces
+// nor allocate.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation,
+          GridSymmetry Symmetry = NoSymmetry>
+bool CheckAllocations() {
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation, Symmetry>;
+
+  auto lMax = 32;
+  auto nMax = 2;
+  auto grid = Grid(lMax, nMax);
+
+  auto f = FFTWpp::vector<Real>(grid.ComponentSize());
+  auto g = FFTWpp::vector<Complex>(grid.ComponentSize());
+  auto flm = FFTWpp::vector<Complex>(grid.RealCoefficientSize(lMax, 0));
+  grid.RandomRealCoefficient(lMax, 0, flm);
+  auto n = nMax - 1;
+  auto glm = FFTWpp::vector<Complex>(grid.ComplexCoefficientSize(lMax, n));
+  grid.RandomComplexCoefficient(lMax, n, glm);
+
+  auto transforms = [&]() {
+    grid.InverseTransformation(lMax, 0, flm, f);
+    grid.ForwardTransformation(lMax, 0, f, flm);
+    grid.InverseTransformation(lMax, n, glm, g);
+    grid.ForwardTransformation(lMax, n, g, glm);
+  };
+
+  // Warm up so that each thread has taken its work arrays.
+  for (auto i = 0; i < 2; i++) transforms();
+  auto built = grid.WorkspacesBuilt();
+  auto allocations = Allocations();
+  for (auto i = 0; i < 3; i++) transforms();
+  return built == 0 || grid.WorkspacesBuilt() != built ||
+         Allocations() != allocations;
+}
+
+#endif  // CHECK_ALLOCATIONS_GUARD_H
@@ -0,0 +1,82 @@
+#ifndef CHECK_BATCH_GUARD_H
+#define CHECK_BATCH_GUARD_H
+
+#include <FFTWpp/Core>
+#include <GSHTrans/All>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include "TransformsAgree.h"
+
+using namespace GSHTrans;
+
+// Checks that batched transforms match those of each field in turn, for
+// real fields and for complex fields with each upper index.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation,
+          GridSymmetry Symmetry = NoSymmetry, IndexRange NStorage = All>
+bool CheckBatch() {
+  using Complex = std::complex<Real>;
+  using Grid =
+      GaussLegendreGrid<Real, All, All, Evaluation, Symmetry, NStorage>;
+
+  auto lMax = 20;
+  auto nMax = 2;
+  auto batch = 5;
+  auto grid = Grid(lMax, nMax);
+  grid.SetNumberOfThreads(2);
+  auto fieldSize = static_cast<int>(grid.ComponentSize());
+
+  // Compares batched transformations with those of each member, given
+  // the coefficient size and a function that makes random coefficients.
+  auto check = [&]<typename Scalar>(Scalar, int n, int size, auto random) {
+    auto flm = FFTWpp::vector<Complex>(batch * size);
+    auto f = FFTWpp::vector<Scalar>(batch * fieldSize);
+    auto glm = FFTWpp::vector<Complex>(batch * size);
+    for (auto k = 0; k < batch; k++) {
+      auto member = FFTWpp::vector<Complex>(size);
+      random(member);
+      std::ranges::copy(member, std::next(flm.begin(), k * size));
+    }
+    grid.InverseTransformations(lMax, n, flm, f);
+    grid.ForwardTransformations(lMax, n, f, glm);
+    for (auto k = 0; k < batch; k++) {
+      auto member = FFTWpp::vector<Complex>(std::next(flm.begin(), k * size),
+                                            std::next(flm.begin(),
+                                                      (k + 1) * size));
+      auto g = FFTWpp::vector<Scalar>(fieldSize);
+      auto hlm = FFTWpp::vector<Complex>(size);
+      grid.InverseTransformation(lMax, n, member, g);
+      grid.ForwardTransformation(lMax, n, g, hlm);
+      auto fk = std::ranges::subrange(std::next(f.begin(), k * fieldSize),
+                                      std::next(f.begin(),
+                                                (k + 1) * fieldSize));
+      auto glmk = std::ranges::subrange(std::next(glm.begin(), k * size),
+                                        std::next(glm.begin(),
+                                                  (k + 1) * size));
+      if (!Close(fk, g) || !Close(glmk, hlm) || !Close(glmk, member)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto realSize = static_cast<int>(grid.RealCoefficientSize(lMax, 0));
+  if (check(Real{}, 0, realSize, [&](auto& flm) {
+        grid.RandomRealCoefficient(lMax, 0, flm);
+      })) {
+    return true;
+  }
+  for (auto n : grid.UpperIndices()) {
+    auto size = static_cast<int>(grid.ComplexCoefficientSize(lMax, n));
+    if (check(Complex{}, n, size, [&](auto& flm) {
+          grid.RandomComplexCoefficient(lMax, n, flm);
+        })) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#endif  // CHECK_BATCH_GUARD_H
@@ -0,0 +1,63 @@
+#ifndef CHECK_BATCH_RECURSION_GUARD
+#define CHECK_BATCH_RECURSION_GUARD
+
+#include <GSHTrans/All>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+// Check that values computed for batches of colatitudes at once match
+// those found by running the recursion for one upper index and one
+// colatitude at a time. The number of colatitudes leaves some over after
+// the full batches, and includes the poles.
+template <std::floating_point Real, GSHTrans::OrderIndexRange MRange,
+          GSHTrans::IndexRange NRange, GSHTrans::IndexRange NStorage = NRange>
+int CheckBatchRecursion() {
+  using namespace GSHTrans;
+  using Int = std::ptrdiff_t;
+
+  int lMax = 50;
+  int mMax = 30;
+  int nMax = 3;
+
+  auto theta = std::vector<Real>{};
+  for (auto i = 0; i < 19; i++) {
+    theta.push_back(std::numbers::pi_v<Real> * i / 18);
+  }
+
+  auto d = [&]() {
+    using WignerType =
+        Wigner<Real, Ortho, MRange, NRange, Multiple, ColumnMajor, NStorage>;
+    if constexpr (std::same_as<NRange, Sparse>) {
+      return WignerType(lMax, mMax, std::vector<Int>{-nMax, 0, 1, nMax},
+                        theta);
+    } else {
+      return WignerType(lMax, mMax, nMax, theta);
+    }
+  }();
+
+  constexpr auto eps = 10 * std::numeric_limits<Real>::epsilon();
+  for (auto n : d.UpperIndices()) {
+    // Values for negative n are then found by symmetry, not computed.
+    if (!std::same_as<NStorage, NRange> && n < 0) continue;
+    for (auto iTheta = 0; iTheta < static_cast<int>(theta.size()); iTheta++) {
+      auto e = Wigner<Real, Ortho, MRange, Single, Single>(lMax, mMax, n,
+                                                           theta[iTheta]);
+      for (auto l = std::abs(n); l <= lMax; l++) {
+        auto dl = d(n, iTheta)(l);
+        auto el = e(n, 0)(l);
+        for (auto m : el.Orders()) {
+          auto scale = std::max(Real{1}, std::abs(el(m)));
+          if (std::abs(dl(m) - el(m)) > eps * scale) return 1;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif  // CHECK_BATCH_RECURSION_GUARD
@@ -0,0 +1,175 @@
+#ifndef CHECK_CACHE_GUARD_H
+#define CHECK_CACHE_GUARD_H
+
+#include <unistd.h>
+
+#include <FFTWpp/Core>
+#include <GSHTrans/All>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace GSHTrans;
+
+// Checks that a grid constructed from a cache file gives the same results
+// as the grid that wrote it.
+template <RealFloatingPoint Real, OrderIndexRange MRange, IndexRange NRange,
+          WignerEvaluation Evaluation = Precomputed,
+          GridSymmetry Symmetry = NoSymmetry>
+bool CheckCache() {
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, MRange, NRange, Evaluation, Symmetry>;
+
+  auto directory = std::filesystem::temp_directory_path() /
+                   ("GSHTransCache" + std::to_string(::getpid()));
+  std::filesystem::create_directories(directory);
+
+  auto lMax = 32;
+  auto nMax = 2;
+  auto makeGrid = [&]() {
+    if constexpr (std::same_as<NRange, Sparse>) {
+      return Grid(lMax, std::vector<std::ptrdiff_t>{-nMax, 0, nMax},
+                  directory);
+    } else {
+      return Grid(lMax, nMax, directory);
+    }
+  };
+  // The cold grid is destroyed before the warm one is made so that the
+  // values are not shared between them through the registry.
+  auto cold = std::make_unique<Grid>(makeGrid());
+  auto exists = std::filesystem::exists(directory / cold->CacheFileName());
+  auto points = std::vector<Real>(cold->CoLatitudes().begin(),
+                                  cold->CoLatitudes().end());
+  auto weights = std::vector<Real>(cold->CoLatitudeWeights().begin(),
+                                   cold->CoLatitudeWeights().end());
+  auto coefficients = std::vector<FFTWpp::vector<Complex>>{};
+  auto fields = std::vector<FFTWpp::vector<Real>>{};
+  for (auto n : cold->UpperIndices()) {
+    auto& flm = coefficients.emplace_back(cold->RealCoefficientSize(lMax, n));
+    cold->RandomRealCoefficient(lMax, n, flm);
+    auto& f = fields.emplace_back(cold->ComponentSize());
+    cold->InverseTransformation(lMax, n, flm, f);
+  }
+  cold.reset();
+
+  auto warm = makeGrid();
+  std::filesystem::remove_all(directory);
+  if (!exists) return true;
+
+  if (!std::ranges::equal(points, warm.CoLatitudes()) ||
+      !std::ranges::equal(weights, warm.CoLatitudeWeights())) {
+    return true;
+  }
+
+  auto i = 0;
+  for (auto n : warm.UpperIndices()) {
+    auto g = FFTWpp::vector<Real>(warm.ComponentSize());
+    warm.InverseTransformation(lMax, n, coefficients[i], g);
+    if (!std::ranges::equal(fields[i++], g)) return true;
+  }
+
+  return false;
+}
+
+// Checks that a cache file whose header records the wrong size for one of
+// its arrays is not used, and that the values are recomputed instead.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation = Precomputed>
+bool CheckCacheSizes(std::size_t array) {
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation>;
+
+  auto directory = std::filesystem::temp_directory_path() /
+                   ("GSHTransCacheSizes" + std::to_string(::getpid()));
+  std::filesystem::create_directories(directory);
+
+  auto lMax = 32;
+  auto nMax = 2;
+  auto path = directory / Grid(lMax, nMax, directory).CacheFileName();
+  if (!std::filesystem::exists(path)) {
+    std::filesystem::remove_all(directory);
+    return false;
+  }
+
+  // The header holds the magic number, the version, the length of the key
+  // and the key itself, followed by the number of arrays and their sizes.
+  {
+    auto file = std::fstream(path, std::ios::in | std::ios::out |
+                                       std::ios::binary);
+    auto word = [&](std::size_t i) {
+      auto value = std::int64_t{};
+      file.seekg(i * sizeof(value));
+      file.read(reinterpret_cast<char*>(&value), sizeof(value));
+      return value;
+    };
+    auto i = 4 + static_cast<std::size_t>(word(2)) + array;
+    auto size = word(i) - static_cast<std::int64_t>(sizeof(Real));
+    file.seekp(i * sizeof(size));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    if (!file) {
+      std::filesystem::remove_all(directory);
+      return true;
+    }
+  }
+
+  // As above, the grid reading the cache is destroyed before the fresh
+  // one is made.
+  auto cached = std::make_unique<Grid>(lMax, nMax, directory);
+  std::filesystem::remove_all(directory);
+  auto points = std::vector<Real>(cached->CoLatitudes().begin(),
+                                  cached->CoLatitudes().end());
+  auto weights = std::vector<Real>(cached->CoLatitudeWeights().begin(),
+                                   cached->CoLatitudeWeights().end());
+  auto coefficients = std::vector<FFTWpp::vector<Complex>>{};
+  auto fields = std::vector<FFTWpp::vector<Real>>{};
+  for (auto n : cached->UpperIndices()) {
+    auto& flm =
+        coefficients.emplace_back(cached->RealCoefficientSize(lMax, n));
+    cached->RandomRealCoefficient(lMax, n, flm);
+    auto& f = fields.emplace_back(cached->ComponentSize());
+    cached->InverseTransformation(lMax, n, flm, f);
+  }
+  cached.reset();
+
+  auto fresh = Grid(lMax, nMax);
+  if (!std::ranges::equal(points, fresh.CoLatitudes()) ||
+      !std::ranges::equal(weights, fresh.CoLatitudeWeights())) {
+    return true;
+  }
+
+  auto i = 0;
+  for (auto n : fresh.UpperIndices()) {
+    auto g = FFTWpp::vector<Real>(fresh.ComponentSize());
+    fresh.InverseTransformation(lMax, n, coefficients[i], g);
+    if (!std::ranges::equal(fields[i++], g)) return true;
+  }
+
+  return false;
+}
+
+// Checks that grids differing only in how their Wigner values are
+// evaluated have distinct cache and tuning files.
+inline bool CheckCacheNames() {
+  auto lMax = 16;
+  auto nMax = 2;
+  auto names = [&]<WignerEvaluation Evaluation>(Evaluation) {
+    auto grid = GaussLegendreGrid<double, All, All, Evaluation>(lMax, nMax);
+    return std::pair(grid.CacheFileName(), grid.TuningFileName());
+  };
+  auto precomputed = names(Precomputed{});
+  auto onTheFly = names(OnTheFly{});
+  auto lazy = names(Lazy{});
+  auto distinct = [](const auto& a, const auto& b) {
+    return a.first != b.first && a.second != b.second;
+  };
+  return !distinct(precomputed, onTheFly) || !distinct(precomputed, lazy) ||
+         !distinct(onTheFly, lazy);
+}
+
+#endif  // CHECK_CACHE_GUARD_H
@@ -0,0 +1,66 @@
+#ifndef CHECK_CANONICAL_COMPONENTS_GUARD_H
+#define CHECK_CANONICAL_COMPONENTS_GUARD_H
+
+#include <GSHTrans/All>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <limits>
+#include <numbers>
+
+// Check arithmetic on canonical components and their integrals over the
+// sphere against values found directly from the interpolated functions.
+// Scalars of the other precision are included to check that the result
+// keeps the precision of the component.
+template <std::floating_point Real>
+int CheckCanonicalComponents() {
+  using namespace GSHTrans;
+  using Complex = std::complex<Real>;
+  using Other = std::conditional_t<std::same_as<Real, float>, double, float>;
+  using Grid = GaussLegendreGrid<Real, All, All>;
+
+  auto lMax = 16;
+  auto grid = Grid(lMax, 2);
+
+  auto f = [](Real theta, Real phi) {
+    return std::sin(theta) * std::exp(Complex(0, phi));
+  };
+
+  auto x = CanonicalComponent<Grid, ComplexValued>(grid, 0, f);
+  auto y = grid.InterpolateFunction(f) | FormCanonicalComponentView(grid, 0);
+  auto one = CanonicalComponent<Grid, RealValued>(grid, 0, Real{1});
+
+  constexpr auto eps = 100 * std::numeric_limits<Real>::epsilon();
+  constexpr auto pi = std::numbers::pi_v<Real>;
+  auto close = [eps](auto a, auto b) {
+    return std::abs(a - b) <= eps * std::max(Real{1}, std::abs(b));
+  };
+
+  // Pointwise values of an expression built from views.
+  auto z = CanonicalComponent<Grid, ComplexValued>(x * y / 2 + x - 1);
+  auto i = 0;
+  for (auto [theta, phi] : grid.Points()) {
+    auto fp = f(theta, phi);
+    if (!close(z[i++], fp * fp / Real{2} + fp - Real{1})) return 1;
+  }
+
+  // Integrals with known values.
+  if (!close(Integrate(one), 4 * pi)) return 1;
+  if (!close(Integrate(x * conj(y)), Complex(8 * pi / 3))) return 1;
+  if (!close(Integrate(pow(abs(x), 2)), 8 * pi / 3)) return 1;
+  if (!close(Integrate(real(x) * real(y) + imag(x) * imag(y)), 8 * pi / 3)) {
+    return 1;
+  }
+
+  // Scalars of the other precision.
+  auto s = std::complex<Other>(0, 2);
+  auto w = CanonicalComponent<Grid, ComplexValued>(one * s);
+  if (!close(Integrate(w), Complex(0, 8 * pi))) return 1;
+  if (!close(Integrate(one * Other{3} + Other{1}), 16 * pi)) return 1;
+  if (!close(Integrate(x + std::complex<Other>(1)), Complex(4 * pi))) return 1;
+
+  return 0;
+}
+
+#endif  // CHECK_CANONICAL_COMPONENTS_GUARD_H
@@ -0,0 +1,58 @@
+#ifndef CHECK_DERIVATIVE_GUARD
+#define CHECK_DERIVATIVE_GUARD
+
+#include <GSHTrans/All>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+// Compare the derivatives computed alongside the Wigner values to a fourth
+// order finite difference of long double values. The maximum order is
+// less than the maximum degree so that orders beyond those stored are
+// needed.
+template <std::floating_point Real, GSHTrans::OrderIndexRange MRange,
+          GSHTrans::IndexRange NStorage = GSHTrans::All>
+int CheckDerivative() {
+  using namespace GSHTrans;
+
+  int lMax = 20;
+  int mMax = 10;
+  int nMax = 3;
+
+  // Pick a random angle
+  std::random_device rd{};
+  std::mt19937_64 gen{rd()};
+  std::uniform_real_distribution<Real> dist{0.1,
+                                            std::numbers::pi_v<Real> - 0.1};
+  auto theta = dist(gen);
+
+  auto d = Wigner<Real, Ortho, MRange, All, Single, ColumnMajor, NStorage,
+                  WithDerivatives>(lMax, mMax, nMax, theta);
+
+  long double h = 1.0e-5;
+  auto angles = std::vector<long double>{};
+  for (auto i : {-2, -1, 1, 2}) angles.push_back(theta + i * h);
+  auto e = Wigner<long double, Ortho, MRange, All, Multiple>(lMax, mMax, nMax,
+                                                             angles);
+
+  constexpr auto eps = 1000 * std::numeric_limits<Real>::epsilon();
+
+  for (auto n : d.UpperIndices()) {
+    auto dn = d.Derivative(n);
+    for (auto l = std::abs(n); l <= lMax; l++) {
+      for (auto m : dn(l).Orders()) {
+        auto difference = (e(n, 0)(l)(m) - 8 * e(n, 1)(l)(m) +
+                           8 * e(n, 2)(l)(m) - e(n, 3)(l)(m)) /
+                          (12 * h);
+        if (std::abs(dn(l)(m) - difference) > eps * (l + 1)) return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif
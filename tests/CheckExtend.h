@@ -0,0 +1,52 @@
+#ifndef CHECK_EXTEND_GUARD
+#define CHECK_EXTEND_GUARD
+
+#include <GSHTrans/All>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <vector>
+
+// Check that a table extended in steps, both within and beyond its
+// reserved capacity, matches one computed directly.
+template <std::floating_point Real, GSHTrans::OrderIndexRange MRange,
+          GSHTrans::MatrixStorage Storage,
+          GSHTrans::WignerDerivatives Derivatives = GSHTrans::ValuesOnly>
+int CheckExtend() {
+  using namespace GSHTrans;
+  using WignerType =
+      Wigner<Real, Ortho, MRange, All, Multiple, Storage, All, Derivatives>;
+
+  int lMax = 60;
+  int mMax = 40;
+  int nMax = 3;
+
+  auto theta = std::vector<Real>{};
+  for (auto i = 0; i < 11; i++) {
+    theta.push_back(std::numbers::pi_v<Real> * i / 10);
+  }
+
+  auto d = WignerType(8, mMax, nMax, theta, 32);
+  for (auto l : {16, 32, lMax}) d.ExtendTo(l);
+  auto e = WignerType(lMax, mMax, nMax, theta);
+
+  for (auto n : d.UpperIndices()) {
+    for (auto iTheta : d.AngleIndices()) {
+      for (auto l = std::abs(n); l <= lMax; l++) {
+        for (auto m : d(n, iTheta)(l).Orders()) {
+          if (d(n, iTheta)(l)(m) != e(n, iTheta)(l)(m)) return 1;
+          if constexpr (std::same_as<Derivatives, WithDerivatives>) {
+            if (d.Derivative(n, iTheta)(l)(m) !=
+                e.Derivative(n, iTheta)(l)(m)) {
+              return 1;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif
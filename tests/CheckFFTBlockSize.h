@@ -0,0 +1,32 @@
+#ifndef CHECK_FFT_BLOCK_SIZE_GUARD_H
+#define CHECK_FFT_BLOCK_SIZE_GUARD_H
+
+#include <GSHTrans/All>
+
+#include "TransformsAgree.h"
+
+using namespace GSHTrans;
+
+// Checks that transforms do not depend on the number of rows FFT'd
+// together, including block sizes that leave rows over and those larger
+// than the number of colatitudes.
+template <RealFloatingPoint Real, GridSymmetry Symmetry = NoSymmetry>
+bool CheckFFTBlockSize() {
+  using Grid = GaussLegendreGrid<Real, All, All, Precomputed, Symmetry>;
+
+  auto lMax = 24;
+  auto nMax = 1;
+  auto grid = Grid(lMax, nMax);
+  grid.SetFFTBlockSize(1);
+
+  for (auto blockSize : {7, 25, 64}) {
+    auto blocked = Grid(lMax, nMax);
+    blocked.SetFFTBlockSize(blockSize);
+    if (blocked.FFTBlockSize() != blockSize) return true;
+    if (!TransformsAgree(grid, blocked, lMax, false)) return true;
+  }
+
+  return false;
+}
+
+#endif  // CHECK_FFT_BLOCK_SIZE_GUARD_H
@@ -0,0 +1,88 @@
+#ifndef CHECK_HIGH_DEGREE_GUARD
+#define CHECK_HIGH_DEGREE_GUARD
+
+#include <GSHTrans/All>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <numeric>
+
+// Checks that the sum of squares over orders equals one at each degree
+// for an angle and degree where values near the order boundaries are
+// smaller than the least representable number.
+template <std::floating_point Real>
+int CheckHighDegree() {
+  using namespace GSHTrans;
+
+  int lMax = 2000;
+  auto theta = static_cast<Real>(3) / static_cast<Real>(10);
+
+  constexpr auto eps = 10000 * std::numeric_limits<Real>::epsilon();
+
+  for (auto n : {0, 2, -3}) {
+    auto d = Wigner<Real, FourPi, All, Single, Single>(lMax, lMax, n, theta);
+    for (auto l = std::abs(n); l <= lMax; l++) {
+      auto sum = std::inner_product(d(l).begin(), d(l).end(), d(l).begin(),
+                                    Real{0});
+      if (std::abs(sum - 1) > eps) return 1;
+    }
+  }
+
+  return 0;
+}
+
+// Checks unitarity and finiteness up to degree 10000 for upper indices
+// near zero and near the maximum degree. Colatitudes near the pole and
+// near the equator are both used. Near the pole, the values at the
+// extreme orders fall below the least representable number, so only the
+// extended-exponent recursion keeps the others accurate. With n = 0 only
+// non-negative orders are stored, using d^{l}_{-m,0} = (-1)^{m}
+// d^{l}_{m0}.
+template <std::floating_point Real>
+int CheckVeryHighDegree() {
+  using namespace GSHTrans;
+
+  int lMax = 10000;
+  auto pi = std::numbers::pi_v<Real>;
+
+  constexpr auto eps = 100000 * std::numeric_limits<Real>::epsilon();
+
+  // Checks the sums of squares at each degree, and returns whether any
+  // value fell below the least normal number.
+  auto check = [&](auto& d, int n, bool halfOrders, bool& underflow) {
+    for (auto l = std::abs(n); l <= lMax; l++) {
+      auto dl = d(l);
+      auto sum = Real{0};
+      for (auto m : dl.Orders()) {
+        auto value = dl(m);
+        if (!std::isfinite(value)) return false;
+        if (std::abs(value) < std::numeric_limits<Real>::min()) {
+          underflow = true;
+        }
+        sum += (halfOrders && m > 0 ? 2 : 1) * value * value;
+      }
+      if (std::abs(sum - 1) > eps) return false;
+    }
+    return true;
+  };
+
+  for (auto theta : {pi / 100, pi / 2 - pi / 100}) {
+    auto underflow = false;
+    {
+      auto d = Wigner<Real, FourPi, NonNegative, Single, Single>(lMax, lMax,
+                                                                 0, theta);
+      if (!check(d, 0, true, underflow)) return 1;
+    }
+    {
+      auto n = lMax - 2;
+      auto d = Wigner<Real, FourPi, All, Single, Single>(lMax, lMax, n, theta);
+      if (!check(d, n, false, underflow)) return 1;
+    }
+    if (theta < pi / 4 && !underflow) return 1;
+  }
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef CHECK_LAYOUT_GUARD
+#define CHECK_LAYOUT_GUARD
+
+#include <GSHTrans/All>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+// Check that GSHLayout agrees with GSHIndices for every (l,m) of each
+// upper index in the ranges given by NRange, with values for the upper
+// indices stored one after another.
+template <GSHTrans::OrderIndexRange MRange, GSHTrans::IndexRange NRange>
+int CheckLayout() {
+  using namespace GSHTrans;
+  using Int = std::ptrdiff_t;
+
+  auto cases = std::vector<std::array<Int, 3>>{
+      {0, 0, 0}, {12, 12, 3}, {12, 5, 3}, {12, 2, 4}, {7, 20, 7}};
+  for (auto [lMax, mMax, nMax] : cases) {
+    auto upperIndices = std::vector<Int>{};
+    if constexpr (std::same_as<NRange, All>) {
+      for (auto n = -nMax; n <= nMax; n++) upperIndices.push_back(n);
+    } else if constexpr (std::same_as<NRange, NonNegative>) {
+      for (auto n = Int{0}; n <= nMax; n++) upperIndices.push_back(n);
+    } else if constexpr (std::same_as<NRange, Sparse>) {
+      upperIndices = SortedUpperIndices({-nMax, 0, nMax / 2 + 1, nMax});
+      std::erase_if(upperIndices, [&](auto n) { return std::abs(n) > lMax; });
+    } else {
+      upperIndices.push_back(nMax);
+    }
+
+    auto layout = GSHLayout<MRange>(lMax, mMax, upperIndices);
+    auto offset = Int{0};
+    for (auto n : upperIndices) {
+      auto indices = GSHIndices<MRange>(lMax, mMax, n);
+      if (layout.Offset(n) != offset || layout.Size(n) != indices.size()) {
+        return 1;
+      }
+      for (auto l : indices.Degrees()) {
+        if (layout.DegreeOffset(n, l) != indices.OffsetForDegree(l)) return 1;
+        for (auto m : GSHSubIndices<MRange>(l, mMax).Orders()) {
+          auto index = indices.Index(l, m);
+          if (layout.LocalIndex(n, l, m) != index ||
+              layout.Index(n, l, m) != offset + index) {
+            return 1;
+          }
+        }
+      }
+      offset += indices.size();
+    }
+    if (layout.size() != offset) return 1;
+  }
+
+  return 0;
+}
+
+#endif  // CHECK_LAYOUT_GUARD
@@ -0,0 +1,53 @@
+#ifndef CHECK_LAZY_GUARD_H
+#define CHECK_LAZY_GUARD_H
+
+#include <FFTWpp/Core>
+#include <GSHTrans/All>
+#include <algorithm>
+#include <complex>
+#include <thread>
+#include <vector>
+
+using namespace GSHTrans;
+
+// Checks that transforms on a grid with lazily built Wigner values match
+// those on a grid with precomputed values when several threads first use
+// each upper index at the same time.
+template <RealFloatingPoint Real, GridSymmetry Symmetry = NoSymmetry>
+bool CheckLazy() {
+  using Complex = std::complex<Real>;
+  using LazyGrid = GaussLegendreGrid<Real, All, All, Lazy, Symmetry>;
+  using Grid = GaussLegendreGrid<Real, All, All, Precomputed, Symmetry>;
+
+  auto lMax = 32;
+  auto nMax = 2;
+  auto lazy = LazyGrid(lMax, nMax);
+  auto grid = Grid(lMax, nMax);
+  lazy.Prefetch(0);
+
+  auto upperIndices = std::vector<int>{};
+  for (auto n : grid.UpperIndices()) {
+    upperIndices.insert(upperIndices.end(), 4, n);
+  }
+
+  // One char per thread, as elements of a vector<bool> share words.
+  auto results = std::vector<char>(upperIndices.size());
+  auto threads = std::vector<std::thread>{};
+  for (auto i = std::size_t{0}; i < upperIndices.size(); i++) {
+    threads.emplace_back([&, i]() {
+      auto n = upperIndices[i];
+      auto flm = FFTWpp::vector<Complex>(grid.ComplexCoefficientSize(lMax, n));
+      grid.RandomComplexCoefficient(lMax, n, flm);
+      auto f = FFTWpp::vector<Complex>(grid.ComponentSize());
+      auto g = FFTWpp::vector<Complex>(grid.ComponentSize());
+      grid.InverseTransformation(lMax, n, flm, f);
+      lazy.InverseTransformation(lMax, n, flm, g);
+      results[i] = std::ranges::equal(f, g);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  return !std::ranges::all_of(results, [](auto result) { return result; });
+}
+
+#endif  // CHECK_LAZY_GUARD_H
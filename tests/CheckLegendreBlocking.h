@@ -0,0 +1,39 @@
+#ifndef CHECK_LEGENDRE_BLOCKING_GUARD_H
+#define CHECK_LEGENDRE_BLOCKING_GUARD_H
+
+#include <GSHTrans/All>
+#include <array>
+#include <utility>
+
+#include "TransformsAgree.h"
+
+using namespace GSHTrans;
+
+// Checks that transforms summed over small tiles of degrees and
+// colatitudes match those summed over a single tile. Each coefficient and
+// each row value is summed in the same order for any tiling, and so the
+// results must be identical.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation,
+          GridSymmetry Symmetry = NoSymmetry>
+bool CheckLegendreBlocking() {
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation, Symmetry>;
+
+  auto lMax = 40;
+  auto nMax = 2;
+  auto reference = Grid(lMax, nMax);
+  reference.SetNumberOfThreads(1);
+  reference.SetLegendreBlockSizes(lMax + 1, lMax + 1);
+
+  auto blockSizes = std::array{std::pair(1, 1), std::pair(3, 5),
+                               std::pair(7, 2), std::pair(0, 0)};
+  for (auto [degrees, coLatitudes] : blockSizes) {
+    auto grid = Grid(lMax, nMax);
+    grid.SetNumberOfThreads(2);
+    grid.SetLegendreBlockSizes(degrees, coLatitudes);
+    if (!TransformsAgree(reference, grid, lMax, true)) return true;
+  }
+
+  return false;
+}
+
+#endif  // CHECK_LEGENDRE_BLOCKING_GUARD_H
@@ -0,0 +1,182 @@
+#ifndef CHECK_LEGENDRE_KERNELS_GUARD_H
+#define CHECK_LEGENDRE_KERNELS_GUARD_H
+
+#include <GSHTrans/All>
+#include <complex>
+#include <concepts>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace GSHTrans;
+
+// Checks the Legendre kernels against the same sums written using
+// complex arithmetic, with Wigner values of the given precision.
+template <std::floating_point Real, std::floating_point Value>
+bool CheckLegendreKernels() {
+  using Complex = std::complex<Real>;
+
+  std::random_device rd{};
+  std::mt19937_64 gen{rd()};
+  std::uniform_real_distribution<Real> dist{-1, 1};
+  auto random = [&]() { return Complex(dist(gen), dist(gen)); };
+
+  auto size = std::ptrdiff_t{37};
+  auto d = std::vector<Value>(size);
+  for (auto& value : d) value = static_cast<Value>(dist(gen));
+  auto x = std::vector<Complex>(size);
+  auto z = std::vector<Complex>(size);
+  auto y = std::vector<Complex>(size);
+  auto u = std::vector<Complex>(size);
+  for (auto k = 0; k < size; k++) {
+    x[k] = random();
+    z[k] = random();
+    y[k] = random();
+    u[k] = random();
+  }
+  auto c = dist(gen);
+  auto cr = dist(gen);
+  auto dr = d.data() + size - 1;
+
+  constexpr auto eps = 100 * std::numeric_limits<Real>::epsilon();
+  auto close = [&](const auto& a, const auto& b) {
+    for (auto k = 0; k < size; k++) {
+      if (std::abs(a[k] - b[k]) > eps) return false;
+    }
+    return true;
+  };
+  auto value = [&](auto k) { return static_cast<Real>(d[k]); };
+  auto reversed = [&](auto k) { return static_cast<Real>(d[size - 1 - k]); };
+
+  {
+    auto expected = y;
+    for (auto k = 0; k < size; k++) expected[k] += c * value(k) * x[k];
+    auto result = y;
+    LegendreKernels::MultiplyAdd(size, c, d.data(), x.data(), result.data());
+    if (!close(result, expected)) return true;
+  }
+
+  {
+    auto expected = y;
+    for (auto k = 0; k < size; k++) {
+      expected[k] += c * value(k) * x[k] + cr * reversed(k) * z[k];
+    }
+    auto result = y;
+    LegendreKernels::MultiplyAddPair(size, c, d.data(), cr, dr, x.data(),
+                                     z.data(), result.data());
+    if (!close(result, expected)) return true;
+  }
+
+  {
+    auto expectedY = y;
+    auto expectedU = u;
+    for (auto k = 0; k < size; k++) {
+      expectedY[k] += c * value(k) * x[k];
+      expectedU[k] += cr * reversed(k) * x[k];
+    }
+    auto resultY = y;
+    auto resultU = u;
+    LegendreKernels::MultiplyAddSplit(size, c, d.data(), cr, dr, x.data(),
+                                      resultY.data(), resultU.data());
+    if (!close(resultY, expectedY) || !close(resultU, expectedU)) return true;
+  }
+
+  return false;
+}
+
+// Checks the kernels against the loops in LegendreKernels::Fallback for
+// sizes that are and are not multiples of the vector width. The two are
+// the same unless compiled for an instruction set with intrinsic kernels.
+template <std::floating_point Real, std::floating_point Value>
+bool CheckLegendreKernelsFallback() {
+  using Complex = std::complex<Real>;
+
+  std::random_device rd{};
+  std::mt19937_64 gen{rd()};
+  std::uniform_real_distribution<Real> dist{-1, 1};
+  auto random = [&](auto size) {
+    auto x = std::vector<Complex>(size);
+    for (auto& value : x) value = Complex(dist(gen), dist(gen));
+    return x;
+  };
+
+  constexpr auto eps = 100 * std::numeric_limits<Real>::epsilon();
+  auto close = [&](const auto& a, const auto& b) {
+    for (std::size_t k = 0; k < a.size(); k++) {
+      if (std::abs(a[k] - b[k]) > eps) return false;
+    }
+    return true;
+  };
+
+  for (auto size = std::ptrdiff_t{0}; size <= 40; size++) {
+    auto d = std::vector<Value>(size + 1);
+    for (auto& value : d) value = static_cast<Value>(dist(gen));
+    auto x = random(size);
+    auto z = random(size);
+    auto y = random(size);
+    auto u = random(size);
+    auto c = dist(gen);
+    auto cr = dist(gen);
+    auto dr = d.data() + size;
+
+    {
+      auto expected = y;
+      LegendreKernels::Fallback::MultiplyAdd(size, c, d.data(), x.data(),
+                                             expected.data());
+      auto result = y;
+      LegendreKernels::MultiplyAdd(size, c, d.data(), x.data(),
+                                   result.data());
+      if (!close(result, expected)) return true;
+    }
+
+    {
+      auto expected = y;
+      LegendreKernels::Fallback::MultiplyAddPair(
+          size, c, d.data(), cr, dr, x.data(), z.data(), expected.data());
+      auto result = y;
+      LegendreKernels::MultiplyAddPair(size, c, d.data(), cr, dr, x.data(),
+                                       z.data(), result.data());
+      if (!close(result, expected)) return true;
+    }
+
+    {
+      auto expectedY = y;
+      auto expectedU = u;
+      LegendreKernels::Fallback::MultiplyAddSplit(size, c, d.data(), cr, dr,
+                                                  x.data(), expectedY.data(),
+                                                  expectedU.data());
+      auto resultY = y;
+      auto resultU = u;
+      LegendreKernels::MultiplyAddSplit(size, c, d.data(), cr, dr, x.data(),
+                                        resultY.data(), resultU.data());
+      if (!close(resultY, expectedY) || !close(resultU, expectedU)) {
+        return true;
+      }
+    }
+  }
+
+  // Batched kernel, with the first terms skipped for some rows.
+  auto size = std::ptrdiff_t{5};
+  auto terms = std::ptrdiff_t{6};
+  auto first = [](std::ptrdiff_t j) { return j % 3; };
+  for (auto batch = std::ptrdiff_t{1}; batch <= 20; batch++) {
+    auto a = std::vector<Real>(terms * size);
+    for (auto& value : a) value = dist(gen);
+    auto offset = std::vector<std::ptrdiff_t>(terms);
+    for (auto s = 0; s < terms; s++) offset[s] = 2 * s;
+    auto x = random((offset.back() + size) * batch);
+    auto y = random(size * batch);
+    auto expected = y;
+    LegendreKernels::Fallback::MultiplyAddTerms(size, batch, terms, a.data(),
+                                                x.data(), offset.data(),
+                                                expected.data(), first);
+    auto result = y;
+    LegendreKernels::MultiplyAddTerms(size, batch, terms, a.data(), x.data(),
+                                      offset.data(), result.data(), first);
+    if (!close(result, expected)) return true;
+  }
+
+  return false;
+}
+
+#endif  // CHECK_LEGENDRE_KERNELS_GUARD_H
@@ -0,0 +1,44 @@
+#ifndef CHECK_PIPELINED_GUARD_H
+#define CHECK_PIPELINED_GUARD_H
+
+#include <GSHTrans/All>
+#include <array>
+#include <utility>
+
+#include "TransformsAgree.h"
+
+using namespace GSHTrans;
+
+// Checks that pipelined inverse transforms match those whose rows are all
+// summed before being FFT'd, for differing numbers of threads and tile
+// sizes. The rows are FFT'd in differing blocks, and so results can
+// differ by rounding.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation,
+          GridSymmetry Symmetry = NoSymmetry>
+bool CheckPipelined() {
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation, Symmetry>;
+
+  // An odd number of colatitudes places one on the equator.
+  auto lMax = 40;
+  auto nMax = 2;
+  auto reference = Grid(lMax, nMax);
+  reference.SetNumberOfThreads(1);
+  reference.SetFFTBlockSize(4);
+
+  auto blockSizes = std::array{std::pair(0, 0), std::pair(0, 1),
+                               std::pair(5, 3), std::pair(0, 100)};
+  for (auto threads : {1, 2, 3}) {
+    for (auto [degrees, coLatitudes] : blockSizes) {
+      auto grid = reference;
+      grid.SetNumberOfThreads(threads);
+      grid.SetLegendreBlockSizes(degrees, coLatitudes);
+      grid.SetPipelined(true);
+      if (!grid.Pipelined()) return true;
+      if (!TransformsAgree(reference, grid, lMax, false)) return true;
+    }
+  }
+
+  return false;
+}
+
+#endif  // CHECK_PIPELINED_GUARD_H
@@ -0,0 +1,33 @@
+#ifndef CHECK_RECOMPUTE_GUARD
+#define CHECK_RECOMPUTE_GUARD
+
+#include <GSHTrans/All>
+#include <concepts>
+#include <numbers>
+
+// Check that values at a single colatitude computed again in place match
+// those computed directly at the new colatitude.
+template <std::floating_point Real, GSHTrans::OrderIndexRange MRange>
+int CheckRecompute() {
+  using namespace GSHTrans;
+  using WignerType = Wigner<Real, Ortho, MRange, Single, Single, ColumnMajor>;
+
+  int lMax = 60;
+  int n = 2;
+  auto pi = std::numbers::pi_v<Real>;
+
+  auto d = WignerType(lMax, lMax, n, pi / 7);
+  for (auto theta : {pi / 3, Real{0}, 3 * pi / 5, pi}) {
+    d.Recompute(theta);
+    auto e = WignerType(lMax, lMax, n, theta);
+    for (auto l = n; l <= lMax; l++) {
+      for (auto m : d(n, 0)(l).Orders()) {
+        if (d(n, 0)(l)(m) != e(n, 0)(l)(m)) return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif
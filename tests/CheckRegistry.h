@@ -0,0 +1,80 @@
+#ifndef CHECK_REGISTRY_GUARD_H
+#define CHECK_REGISTRY_GUARD_H
+
+#include <GSHTrans/All>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace GSHTrans;
+
+// Checks that objects are shared between users of the same key, built
+// once when asked for concurrently, and freed once no longer used.
+inline bool CheckRegistry() {
+  struct Table {
+    int value;
+  };
+  using Tables = Registry<Table>;
+
+  auto builds = std::atomic<int>{0};
+  auto make = [&builds]() {
+    builds++;
+    return std::make_shared<Table>(builds.load());
+  };
+
+  auto tables = std::vector<std::shared_ptr<Table>>(8);
+  auto threads = std::vector<std::thread>{};
+  for (auto& table : tables) {
+    threads.emplace_back([&]() { table = Tables::Get({32, 2}, make); });
+  }
+  for (auto& thread : threads) thread.join();
+  if (builds != 1 || Tables::size() != 1) return true;
+  for (auto& table : tables) {
+    if (table != tables.front()) return true;
+  }
+
+  auto other = Tables::Get({64, 2}, make);
+  if (builds != 2 || other == tables.front() || Tables::size() != 2) {
+    return true;
+  }
+
+  tables.clear();
+  other.reset();
+  if (Tables::size() != 0) return true;
+  auto table = Tables::Get({32, 2}, make);
+  return builds != 3 || table->value != 3;
+}
+
+// Checks that objects for different keys are built concurrently. The
+// first build waits for the second to start, giving up after a time, and
+// so only sees it if the second is not blocked while the first runs.
+inline bool CheckRegistryConcurrentKeys() {
+  struct Table {
+    bool overlapped;
+  };
+  using Tables = Registry<Table>;
+
+  using Clock = std::chrono::steady_clock;
+  auto started = std::atomic<bool>{false};
+  auto first = std::shared_ptr<Table>{};
+  auto thread = std::thread([&]() {
+    first = Tables::Get({32, 2}, [&]() {
+      auto deadline = Clock::now() + std::chrono::seconds(10);
+      while (!started && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return std::make_shared<Table>(started.load());
+    });
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto second = Tables::Get({64, 2}, [&]() {
+    started = true;
+    return std::make_shared<Table>(true);
+  });
+  thread.join();
+  return !first->overlapped || Tables::size() != 2;
+}
+
+#endif  // CHECK_REGISTRY_GUARD_H
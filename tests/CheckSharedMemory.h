@@ -0,0 +1,102 @@
+#ifndef CHECK_SHARED_MEMORY_GUARD_H
+#define CHECK_SHARED_MEMORY_GUARD_H
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <FFTWpp/Core>
+#include <GSHTrans/All>
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace GSHTrans;
+
+// Checks that a grid mapping its values from a shared memory segment gives
+// the same results as the grid that created the segment.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation = Precomputed>
+bool CheckSharedMemory() {
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation>;
+
+  auto shared = SharedMemory{"GSHTransTest" + std::to_string(::getpid())};
+  auto lMax = 32;
+  auto nMax = 2;
+
+  // The first grid is destroyed before the second is made so that the
+  // values are not shared between them through the registry.
+  auto first = std::make_unique<Grid>(lMax, nMax, shared);
+  auto name = first->SharedMemoryName(shared);
+  auto exists = SharedSegment::Exists(name);
+  auto coefficients = std::vector<FFTWpp::vector<Complex>>{};
+  auto fields = std::vector<FFTWpp::vector<Real>>{};
+  for (auto n : first->UpperIndices()) {
+    auto& flm = coefficients.emplace_back(first->RealCoefficientSize(lMax, n));
+    first->RandomRealCoefficient(lMax, n, flm);
+    auto& f = fields.emplace_back(first->ComponentSize());
+    first->InverseTransformation(lMax, n, flm, f);
+  }
+  first.reset();
+
+  auto second = Grid(lMax, nMax, shared);
+  SharedSegment::Remove(name);
+  if (!exists || SharedSegment::Exists(name)) return true;
+
+  auto i = 0;
+  for (auto n : second.UpperIndices()) {
+    auto g = FFTWpp::vector<Real>(second.ComponentSize());
+    second.InverseTransformation(lMax, n, coefficients[i], g);
+    if (!std::ranges::equal(fields[i++], g)) return true;
+  }
+
+  return false;
+}
+
+// Checks that a segment left by a creator that died before writing it is
+// removed and created again, rather than waited on until the timeout.
+template <RealFloatingPoint Real>
+bool CheckSharedMemoryOrphaned() {
+  using Complex = std::complex<Real>;
+  using Grid = GaussLegendreGrid<Real, All, All>;
+  using Clock = std::chrono::steady_clock;
+
+  auto shared = SharedMemory{"GSHTransOrphan" + std::to_string(::getpid())};
+  auto lMax = 32;
+  auto nMax = 2;
+  auto reference = Grid(lMax, nMax);
+  auto name = reference.SharedMemoryName(shared);
+
+  // The child creates the segment and exits without writing it.
+  auto child = ::fork();
+  if (child == 0) ::_exit(SharedSegment::Create(name) ? 0 : 1);
+  auto status = 0;
+  ::waitpid(child, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return true;
+
+  auto start = Clock::now();
+  auto grid = Grid(lMax, nMax, shared);
+  auto waited = Clock::now() - start;
+  auto exists = SharedSegment::Exists(name);
+  auto owner = SharedSegment(name).Owner();
+  SharedSegment::Remove(name);
+  if (waited > std::chrono::seconds(30) || !exists || owner != ::getpid()) {
+    return true;
+  }
+
+  for (auto n : grid.UpperIndices()) {
+    auto flm = FFTWpp::vector<Complex>(grid.RealCoefficientSize(lMax, n));
+    grid.RandomRealCoefficient(lMax, n, flm);
+    auto f = FFTWpp::vector<Real>(grid.ComponentSize());
+    auto g = FFTWpp::vector<Real>(grid.ComponentSize());
+    reference.InverseTransformation(lMax, n, flm, f);
+    grid.InverseTransformation(lMax, n, flm, g);
+    if (!std::ranges::equal(f, g)) return true;
+  }
+
+  return false;
+}
+
+#endif  // CHECK_SHARED_MEMORY_GUARD_H
@@ -0,0 +1,53 @@
+#ifndef CHECK_SPARSE_GUARD
+#define CHECK_SPARSE_GUARD
+
+#include <GSHTrans/All>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <vector>
+
+// Check that values for a sparse set of upper indices match those for
+// the full range, and that only the indices in the set are stored.
+template <std::floating_point Real, GSHTrans::OrderIndexRange MRange,
+          GSHTrans::MatrixStorage Storage>
+int CheckSparse() {
+  using namespace GSHTrans;
+  using Int = std::ptrdiff_t;
+
+  int lMax = 60;
+  int mMax = 40;
+  int nMax = 2;
+
+  auto theta = std::vector<Real>{};
+  for (auto i = 0; i < 11; i++) {
+    theta.push_back(std::numbers::pi_v<Real> * i / 10);
+  }
+
+  auto d = Wigner<Real, Ortho, MRange, Sparse, Multiple, Storage>(
+      lMax, mMax, std::vector<Int>{2, -2, 0, 2}, theta);
+  auto e = Wigner<Real, Ortho, MRange, All, Multiple, Storage>(lMax, mMax,
+                                                               nMax, theta);
+
+  if (!std::ranges::equal(d.UpperIndices(), std::vector<Int>{-2, 0, 2})) {
+    return 1;
+  }
+  if (d.MinUpperIndex() != -2 || d.MaxUpperIndex() != 2) return 1;
+
+  auto size = Int{0};
+  for (auto n : d.UpperIndices()) {
+    for (auto iTheta : d.AngleIndices()) {
+      for (auto l = std::abs(n); l <= lMax; l++) {
+        for (auto m : d(n, iTheta)(l).Orders()) {
+          if (d(n, iTheta)(l)(m) != e(n, iTheta)(l)(m)) return 1;
+          size++;
+        }
+      }
+    }
+  }
+  if (static_cast<Int>(d.size()) != size) return 1;
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef CHECK_THREADS_GUARD_H
+#define CHECK_THREADS_GUARD_H
+
+#include <GSHTrans/All>
+#include <concepts>
+
+#include "TransformsAgree.h"
+
+using namespace GSHTrans;
+
+// Checks that transforms using several threads match those using one.
+// With stored Wigner values each coefficient is summed in the same order
+// and so the results must be identical. With values computed on the fly,
+// the forward transforms add per-thread partial sums in chunk order, and
+// so agree only to within rounding for each number of threads.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation,
+          GridSymmetry Symmetry = NoSymmetry>
+bool CheckThreads() {
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation, Symmetry>;
+
+  auto lMax = 40;
+  auto nMax = 2;
+  auto serial = Grid(lMax, nMax);
+  serial.SetNumberOfThreads(1);
+
+  auto exact = !std::same_as<Evaluation, OnTheFly>;
+  for (auto threads : {2, 3, 4}) {
+    auto parallel = Grid(lMax, nMax);
+    parallel.SetNumberOfThreads(threads);
+    if (!TransformsAgree(serial, parallel, lMax, exact)) return true;
+  }
+  return false;
+}
+
+#endif  // CHECK_THREADS_GUARD_H
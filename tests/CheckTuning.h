@@ -0,0 +1,79 @@
+#ifndef CHECK_TUNING_GUARD_H
+#define CHECK_TUNING_GUARD_H
+
+#include <unistd.h>
+
+#include <GSHTrans/All>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "TransformsAgree.h"
+
+using namespace GSHTrans;
+
+// Checks that autotuned transforms agree with those using the default
+// settings, that the tuning chosen is reused by later grids within the
+// process, and that one saved to a file is read back by a later grid
+// unless it was saved on another machine. Also checks that FFTW wisdom
+// is saved alongside the tuning.
+template <RealFloatingPoint Real, WignerEvaluation Evaluation,
+          GridSymmetry Symmetry = NoSymmetry>
+bool CheckTuning() {
+  using Grid = GaussLegendreGrid<Real, All, All, Evaluation, Symmetry>;
+
+  auto directory = std::filesystem::temp_directory_path() /
+                   ("GSHTransTuning" + std::to_string(::getpid()));
+  std::filesystem::create_directories(directory);
+
+  auto lMax = 32;
+  auto nMax = 2;
+  auto reference = Grid(lMax, nMax);
+  Tunings::Clear();
+  auto grid = Grid(lMax, nMax);
+  grid.Autotune(directory);
+  auto tuning = grid.Tuning();
+  auto path = directory / grid.TuningFileName();
+  auto written = Tunings::Read(path);
+  auto wisdom = std::filesystem::exists(directory / grid.WisdomFileName());
+
+  // A later grid takes the tuning chosen within the process.
+  auto later = Grid(lMax, nMax);
+  later.Autotune();
+  auto reused = later.Tuning() == tuning;
+
+  // With the process's tunings forgotten, a grid reads the tuning from
+  // the file, here replaced by one that timing would be unlikely to pick.
+  auto saved = GridTuning{1, 5, 3, 2, true};
+  Tunings::Clear();
+  Tunings::Write(path, saved);
+  auto restarted = Grid(lMax, nMax);
+  restarted.Autotune(directory);
+  auto read = restarted.Tuning() == saved;
+
+  // The same tuning recorded as made on another machine is ignored, as
+  // the FFT block size is not among those tried.
+  Tunings::Clear();
+  Tunings::Write(path, saved);
+  {
+    auto file = std::ifstream(path);
+    auto settings = std::string{};
+    std::getline(file, settings);
+    file.close();
+    std::ofstream(path) << settings << "\nAnother machine\n";
+  }
+  auto moved = Grid(lMax, nMax);
+  moved.Autotune(directory);
+  auto ignored = moved.Tuning() != saved;
+
+  std::filesystem::remove_all(directory);
+  Tunings::Clear();
+  if (!written || *written != tuning || !wisdom || !reused || !read ||
+      !ignored) {
+    return true;
+  }
+  return !TransformsAgree(reference, grid, lMax, false) ||
+         !TransformsAgree(reference, restarted, lMax, false);
+}
+
+#endif  // CHECK_TUNING_GUARD_H
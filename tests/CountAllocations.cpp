@@ -0,0 +1,101 @@
+// Replaces the global allocation functions, and where FFTW is available
+// its own allocators, with ones that count the allocations made. Linked
+// only into the grid tests, whose allocation check reads the count.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if __has_include(<fftw3.h>)
+#include <dlfcn.h>
+#include <fftw3.h>
+#endif
+
+namespace {
+std::atomic<long> allocations = 0;
+
+void* Allocate(std::size_t size, std::size_t alignment) {
+  allocations++;
+  // aligned_alloc needs a size that is a multiple of the alignment.
+  size = (std::max(size, std::size_t{1}) + alignment - 1) / alignment *
+         alignment;
+  if (auto pointer = std::aligned_alloc(alignment, size)) return pointer;
+  throw std::bad_alloc();
+}
+}  // namespace
+
+long Allocations() { return allocations; }
+
+void* operator new(std::size_t size) {
+  return Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+  return Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t,
+                       std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+#if __has_include(<fftw3.h>)
+// FFTWpp's vectors and FFTW's planner allocate through these, which are
+// counted and then passed on to FFTW's own definitions.
+namespace {
+template <typename Function>
+void* Forward(const char* name, std::size_t size) {
+  allocations++;
+  static auto next = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+  return next(size);
+}
+}  // namespace
+
+extern "C" {
+void* fftw_malloc(std::size_t size) {
+  return Forward<decltype(&fftw_malloc)>("fftw_malloc", size);
+}
+
+void* fftwf_malloc(std::size_t size) {
+  return Forward<decltype(&fftwf_malloc)>("fftwf_malloc", size);
+}
+
+void* fftwl_malloc(std::size_t size) {
+  return Forward<decltype(&fftwl_malloc)>("fftwl_malloc", size);
+}
+}
+#endif
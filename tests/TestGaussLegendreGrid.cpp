@@ -1,6 +1,19 @@
 #include <gtest/gtest.h>
 
+#include "CheckAllocations.h"
+#include "CheckBatch.h"
+#include "CheckCache.h"
+#include "CheckCanonicalComponents.h"
 #include "CheckCoeff2Coeff.h"
+#include "CheckFFTBlockSize.h"
+#include "CheckLazy.h"
+#include "CheckLegendreBlocking.h"
+#include "CheckLegendreKernels.h"
+#include "CheckPipelined.h"
+#include "CheckRegistry.h"
+#include "CheckSharedMemory.h"
+#include "CheckThreads.h"
+#include "CheckTuning.h"
 
 TEST(GaussLegendreGrid, Coeff2CoeffDoubleR2C) {
   using Scalar = double;
@@ -14,6 +27,12 @@ TEST(GaussLegendreGrid, Coeff2CoeffLongDoubleR2C) {
   EXPECT_FALSE(result);
 }
 
+TEST(GaussLegendreGrid, Coeff2CoeffFloatR2C) {
+  using Scalar = float;
+  bool result = Coeff2Coeff<Scalar, All, All>();
+  EXPECT_FALSE(result);
+}
+
 TEST(GaussLegendreGrid, Coeff2CoeffDoubleC2C) {
   using Scalar = std::complex<double>;
   bool result = Coeff2Coeff<Scalar, All, All>();
@@ -25,3 +44,317 @@ TEST(GaussLegendreGrid, Coeff2CoeffLongDoubleC2C) {
   bool result = Coeff2Coeff<Scalar, All, All>();
   EXPECT_FALSE(result);
 }
+
+TEST(GaussLegendreGrid, Coeff2CoeffFloatC2C) {
+  using Scalar = std::complex<float>;
+  bool result = Coeff2Coeff<Scalar, All, All>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleR2COnTheFly) {
+  using Scalar = double;
+  bool result = Coeff2Coeff<Scalar, All, All, OnTheFly>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleC2COnTheFly) {
+  using Scalar = std::complex<double>;
+  bool result = Coeff2Coeff<Scalar, All, All, OnTheFly>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleR2CLazy) {
+  using Scalar = double;
+  bool result = Coeff2Coeff<Scalar, All, All, Lazy>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleC2CLazy) {
+  using Scalar = std::complex<double>;
+  bool result = Coeff2Coeff<Scalar, All, All, Lazy>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleR2CEquatorial) {
+  using Scalar = double;
+  bool result = Coeff2Coeff<Scalar, All, All, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleC2CEquatorial) {
+  using Scalar = std::complex<double>;
+  bool result = Coeff2Coeff<Scalar, All, All, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleR2CNonNegativeStorage) {
+  using Scalar = double;
+  bool result =
+      Coeff2Coeff<Scalar, All, All, Precomputed, NoSymmetry, NonNegative>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleC2CNonNegativeStorage) {
+  using Scalar = std::complex<double>;
+  bool result =
+      Coeff2Coeff<Scalar, All, All, Precomputed, NoSymmetry, NonNegative>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleR2CSparse) {
+  using Scalar = double;
+  bool result = Coeff2Coeff<Scalar, All, Sparse>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleC2CSparseEquatorial) {
+  using Scalar = std::complex<double>;
+  bool result = Coeff2Coeff<Scalar, All, Sparse, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CacheDouble) {
+  bool result = CheckCache<double, All, All>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CacheFloat) {
+  bool result = CheckCache<float, All, All>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CacheDoubleEquatorial) {
+  bool result = CheckCache<double, All, All, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CacheDoubleSparse) {
+  bool result = CheckCache<double, All, Sparse>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CacheSizesPoints) {
+  bool result = CheckCacheSizes<double>(0);
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CacheSizesWigner) {
+  bool result = CheckCacheSizes<double>(2);
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CacheNames) {
+  bool result = CheckCacheNames();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleR2CSinglePrecisionWigner) {
+  using Scalar = double;
+  bool result = Coeff2Coeff<Scalar, All, All, Precomputed, NoSymmetry, All,
+                            SinglePrecision>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Coeff2CoeffDoubleC2CSinglePrecisionWigner) {
+  using Scalar = std::complex<double>;
+  bool result = Coeff2Coeff<Scalar, All, All, Precomputed, NoSymmetry, All,
+                            SinglePrecision>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LazyDouble) {
+  bool result = CheckLazy<double>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LazyDoubleEquatorial) {
+  bool result = CheckLazy<double, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, Registry) {
+  bool result = CheckRegistry();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, RegistryConcurrentKeys) {
+  bool result = CheckRegistryConcurrentKeys();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, SharedMemoryDouble) {
+  bool result = CheckSharedMemory<double>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, SharedMemoryDoubleLazy) {
+  bool result = CheckSharedMemory<double, Lazy>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, SharedMemoryOrphaned) {
+  bool result = CheckSharedMemoryOrphaned<double>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, ThreadsDoublePrecomputed) {
+  bool result = CheckThreads<double, Precomputed>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, ThreadsDoublePrecomputedEquatorial) {
+  bool result = CheckThreads<double, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, ThreadsDoubleLazy) {
+  bool result = CheckThreads<double, Lazy>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, ThreadsDoubleOnTheFly) {
+  bool result = CheckThreads<double, OnTheFly>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, ThreadsDoubleOnTheFlyEquatorial) {
+  bool result = CheckThreads<double, OnTheFly, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, FFTBlockSizeDouble) {
+  bool result = CheckFFTBlockSize<double>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, FFTBlockSizeDoubleEquatorial) {
+  bool result = CheckFFTBlockSize<double, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+// Rows of single precision fields start at offsets that are not aligned
+// for SIMD.
+TEST(GaussLegendreGrid, FFTBlockSizeFloat) {
+  bool result = CheckFFTBlockSize<float>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreKernelsDouble) {
+  bool result = CheckLegendreKernels<double, double>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreKernelsDoubleFloatValues) {
+  bool result = CheckLegendreKernels<double, float>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreKernelsFloat) {
+  bool result = CheckLegendreKernels<float, float>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreKernelsFallbackDouble) {
+  bool result = CheckLegendreKernelsFallback<double, double>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreKernelsFallbackDoubleFloatValues) {
+  bool result = CheckLegendreKernelsFallback<double, float>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreKernelsFallbackFloat) {
+  bool result = CheckLegendreKernelsFallback<float, float>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, BatchDouble) {
+  bool result = CheckBatch<double, Precomputed>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, BatchFloat) {
+  bool result = CheckBatch<float, Precomputed>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, BatchDoubleEquatorial) {
+  bool result = CheckBatch<double, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, BatchDoubleOnTheFly) {
+  bool result = CheckBatch<double, OnTheFly, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, BatchDoubleNonNegativeStorage) {
+  bool result = CheckBatch<double, Precomputed, NoSymmetry, NonNegative>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreBlockingDouble) {
+  bool result = CheckLegendreBlocking<double, Precomputed>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreBlockingDoubleEquatorial) {
+  bool result = CheckLegendreBlocking<double, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, LegendreBlockingDoubleLazy) {
+  bool result = CheckLegendreBlocking<double, Lazy, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, TuningDouble) {
+  bool result = CheckTuning<double, Precomputed>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, TuningDoubleEquatorialOnTheFly) {
+  bool result = CheckTuning<double, OnTheFly, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, PipelinedDouble) {
+  bool result = CheckPipelined<double, Precomputed>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, PipelinedDoubleEquatorial) {
+  bool result = CheckPipelined<double, Precomputed, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, PipelinedDoubleOnTheFlyEquatorial) {
+  bool result = CheckPipelined<double, OnTheFly, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, AllocationsDouble) {
+  bool result = CheckAllocations<double, Precomputed>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, AllocationsDoubleOnTheFly) {
+  bool result = CheckAllocations<double, OnTheFly>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, AllocationsDoubleEquatorialOnTheFly) {
+  bool result = CheckAllocations<double, OnTheFly, Equatorial>();
+  EXPECT_FALSE(result);
+}
+
+TEST(GaussLegendreGrid, CanonicalComponentsDouble) {
+  int i = CheckCanonicalComponents<double>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(GaussLegendreGrid, CanonicalComponentsFloat) {
+  int i = CheckCanonicalComponents<float>();
+  EXPECT_EQ(i, 0);
+}
@@ -1,7 +1,14 @@
 #include <gtest/gtest.h>
 
 #include "CheckAdditionTheorem.h"
+#include "CheckBatchRecursion.h"
+#include "CheckDerivative.h"
+#include "CheckExtend.h"
+#include "CheckHighDegree.h"
+#include "CheckLayout.h"
 #include "CheckLegendre.h"
+#include "CheckRecompute.h"
+#include "CheckSparse.h"
 
 // Compare values for n = 0 to the std library function.
 TEST(Wigner, CheckLegendreDouble) {
@@ -14,6 +21,11 @@ TEST(Wigner, CheckLegendreLongDouble) {
   EXPECT_EQ(i, 0);
 }
 
+TEST(Wigner, CheckLegendreFloat) {
+  int i = CheckLegendre<float>();
+  EXPECT_EQ(i, 0);
+}
+
 // Check the addition theorem is satisfied.
 TEST(Wigner, CheckAdditionTheoremDouble) {
   int i = CheckAdditionTheorem<double>();
@@ -24,3 +36,143 @@ TEST(Wigner, CheckAdditionTheoremLongDouble) {
   int i = CheckAdditionTheorem<long double>();
   EXPECT_EQ(i, 0);
 }
+
+TEST(Wigner, CheckAdditionTheoremFloat) {
+  int i = CheckAdditionTheorem<float>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check the addition theorem when only non-negative upper indices are stored.
+TEST(Wigner, CheckAdditionTheoremNonNegativeStorageDouble) {
+  int i = CheckAdditionTheorem<double, GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check values remain accurate where the recursion needs extended exponents.
+TEST(Wigner, CheckHighDegreeDouble) {
+  int i = CheckHighDegree<double>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckVeryHighDegreeDouble) {
+  int i = CheckVeryHighDegree<double>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check derivatives computed alongside the values.
+TEST(Wigner, CheckDerivativeDouble) {
+  int i = CheckDerivative<double, GSHTrans::All>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckDerivativeNonNegativeOrdersDouble) {
+  int i = CheckDerivative<double, GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckDerivativeNonNegativeStorageDouble) {
+  int i = CheckDerivative<double, GSHTrans::All, GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check tables extended to higher degree match those computed directly.
+TEST(Wigner, CheckExtendDouble) {
+  int i = CheckExtend<double, GSHTrans::All, GSHTrans::ColumnMajor>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckExtendRowMajorWithDerivativesDouble) {
+  int i = CheckExtend<double, GSHTrans::NonNegative, GSHTrans::RowMajor,
+                      GSHTrans::WithDerivatives>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check values computed again in place at a new colatitude.
+TEST(Wigner, CheckRecomputeDouble) {
+  int i = CheckRecompute<double, GSHTrans::All>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckRecomputeNonNegativeOrdersDouble) {
+  int i = CheckRecompute<double, GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check values computed for batches of colatitudes.
+TEST(Wigner, CheckBatchRecursionDouble) {
+  int i = CheckBatchRecursion<double, GSHTrans::All, GSHTrans::All>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckBatchRecursionNonNegativeDouble) {
+  int i = CheckBatchRecursion<double, GSHTrans::All, GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckBatchRecursionNonNegativeStorageDouble) {
+  int i = CheckBatchRecursion<double, GSHTrans::All, GSHTrans::All,
+                              GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckBatchRecursionSparseDouble) {
+  int i = CheckBatchRecursion<double, GSHTrans::All, GSHTrans::Sparse>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckBatchRecursionNonNegativeOrdersFloat) {
+  int i = CheckBatchRecursion<float, GSHTrans::NonNegative, GSHTrans::All>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check values for a sparse set of upper indices.
+TEST(Wigner, CheckSparseDouble) {
+  int i = CheckSparse<double, GSHTrans::All, GSHTrans::ColumnMajor>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckSparseRowMajorDouble) {
+  int i = CheckSparse<double, GSHTrans::NonNegative, GSHTrans::RowMajor>();
+  EXPECT_EQ(i, 0);
+}
+
+// Check the tabulated layout against GSHIndices.
+TEST(Wigner, CheckLayoutAll) {
+  int i = CheckLayout<GSHTrans::All, GSHTrans::All>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckLayoutAllNonNegative) {
+  int i = CheckLayout<GSHTrans::All, GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckLayoutAllSingle) {
+  int i = CheckLayout<GSHTrans::All, GSHTrans::Single>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckLayoutAllSparse) {
+  int i = CheckLayout<GSHTrans::All, GSHTrans::Sparse>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckLayoutNonNegativeAll) {
+  int i = CheckLayout<GSHTrans::NonNegative, GSHTrans::All>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckLayoutNonNegative) {
+  int i = CheckLayout<GSHTrans::NonNegative, GSHTrans::NonNegative>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckLayoutNonNegativeSingle) {
+  int i = CheckLayout<GSHTrans::NonNegative, GSHTrans::Single>();
+  EXPECT_EQ(i, 0);
+}
+
+TEST(Wigner, CheckLayoutNonNegativeSparse) {
+  int i = CheckLayout<GSHTrans::NonNegative, GSHTrans::Sparse>();
+  EXPECT_EQ(i, 0);
+}
@@ -0,0 +1,74 @@
+#ifndef TRANSFORMS_AGREE_GUARD_H
+#define TRANSFORMS_AGREE_GUARD_H
+
+#include <FFTWpp/Core>
+#include <GSHTrans/All>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+
+// Returns true if the values agree to within a multiple of the rounding
+// error, relative to the first value where this exceeds one.
+bool Close(const auto& a, const auto& b) {
+  using Real = GSHTrans::RemoveComplex<
+      std::ranges::range_value_t<decltype(a)>>;
+  constexpr auto eps = 1000 * std::numeric_limits<Real>::epsilon();
+  return std::ranges::equal(a, b, [&](auto x, auto y) {
+    return std::abs(x - y) <= eps * std::max(Real{1}, std::abs(x));
+  });
+}
+
+// Returns true if the two grids give the same inverse and forward
+// transforms of a random real field and of random complex fields for each
+// upper index, either exactly or to within rounding.
+template <typename Grid>
+bool TransformsAgree(const Grid& reference, const Grid& grid,
+                     std::ptrdiff_t lMax, bool exact) {
+  using Real = typename Grid::real_type;
+  using Complex = std::complex<Real>;
+
+  auto agree = [&](const auto& a, const auto& b) {
+    return exact ? std::ranges::equal(a, b) : Close(a, b);
+  };
+
+  // Real field.
+  {
+    auto size = reference.RealCoefficientSize(lMax, 0);
+    auto flm = FFTWpp::vector<Complex>(size);
+    reference.RandomRealCoefficient(lMax, 0, flm);
+    auto f = FFTWpp::vector<Real>(reference.ComponentSize());
+    auto g = FFTWpp::vector<Real>(reference.ComponentSize());
+    reference.InverseTransformation(lMax, 0, flm, f);
+    grid.InverseTransformation(lMax, 0, flm, g);
+    if (!agree(f, g)) return false;
+    auto a = FFTWpp::vector<Complex>(size);
+    auto b = FFTWpp::vector<Complex>(size);
+    reference.ForwardTransformation(lMax, 0, f, a);
+    grid.ForwardTransformation(lMax, 0, f, b);
+    if (!agree(a, b)) return false;
+  }
+
+  // Complex fields.
+  for (auto n : reference.UpperIndices()) {
+    auto size = reference.ComplexCoefficientSize(lMax, n);
+    auto flm = FFTWpp::vector<Complex>(size);
+    reference.RandomComplexCoefficient(lMax, n, flm);
+    auto f = FFTWpp::vector<Complex>(reference.ComponentSize());
+    auto g = FFTWpp::vector<Complex>(reference.ComponentSize());
+    reference.InverseTransformation(lMax, n, flm, f);
+    grid.InverseTransformation(lMax, n, flm, g);
+    if (!agree(f, g)) return false;
+    auto a = FFTWpp::vector<Complex>(size);
+    auto b = FFTWpp::vector<Complex>(size);
+    reference.ForwardTransformation(lMax, n, f, a);
+    grid.ForwardTransformation(lMax, n, f, b);
+    if (!agree(a, b)) return false;
+  }
+
+  return true;
+}
+
+#endif  // TRANSFORMS_AGREE_GUARD_H